@@ -0,0 +1,105 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+
+#include <futoin/any.hpp>
+
+using futoin::any;
+using futoin::any_cast;
+
+namespace {
+    using Small = futoin::string;
+    using Large = std::array<char, 256>;
+
+    template<typename T>
+    T make_value();
+
+    template<>
+    int make_value<int>()
+    {
+        return 1;
+    }
+
+    template<>
+    Small make_value<Small>()
+    {
+        return Small{"short"};
+    }
+
+    template<>
+    Large make_value<Large>()
+    {
+        return Large{};
+    }
+
+    template<typename T>
+    void any_construct(benchmark::State& state)
+    {
+        const T value = make_value<T>();
+
+        while (state.KeepRunning()) {
+            any a{value};
+            benchmark::DoNotOptimize(a);
+        }
+    }
+    BENCHMARK_TEMPLATE(any_construct, int);   // NOLINT
+    BENCHMARK_TEMPLATE(any_construct, Small); // NOLINT
+    BENCHMARK_TEMPLATE(any_construct, Large); // NOLINT
+
+    template<typename T>
+    void any_move(benchmark::State& state)
+    {
+        any a{make_value<T>()};
+
+        while (state.KeepRunning()) {
+            any b{std::move(a)};
+            a = std::move(b);
+            benchmark::DoNotOptimize(a);
+        }
+    }
+    BENCHMARK_TEMPLATE(any_move, int);   // NOLINT
+    BENCHMARK_TEMPLATE(any_move, Small); // NOLINT
+    BENCHMARK_TEMPLATE(any_move, Large); // NOLINT
+
+    template<typename T>
+    void any_cast_ref(benchmark::State& state)
+    {
+        any a{make_value<T>()};
+
+        while (state.KeepRunning()) {
+            benchmark::DoNotOptimize(&any_cast<T&>(a));
+        }
+    }
+    BENCHMARK_TEMPLATE(any_cast_ref, int);   // NOLINT
+    BENCHMARK_TEMPLATE(any_cast_ref, Small); // NOLINT
+    BENCHMARK_TEMPLATE(any_cast_ref, Large); // NOLINT
+
+    void any_reassign(benchmark::State& state)
+    {
+        any a{0};
+        int i = 0;
+
+        while (state.KeepRunning()) {
+            a = ++i;
+            benchmark::DoNotOptimize(a);
+        }
+    }
+    BENCHMARK(any_reassign); // NOLINT
+} // namespace
@@ -0,0 +1,205 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <futoin/ri/asyncsteps.hpp>
+#include <futoin/ri/reactor.hpp>
+#include <futoin/ri/reactorpool.hpp>
+
+using futoin::IAsyncSteps;
+using futoin::IAsyncTool;
+using futoin::ri::AsyncSteps;
+using futoin::ri::Reactor;
+using futoin::ri::ReactorPool;
+
+namespace {
+    constexpr std::size_t STEPS = 64;
+
+    void asyncsteps_sequence(benchmark::State& state)
+    {
+        Reactor reactor;
+        AsyncSteps root(reactor);
+        std::size_t acc = 0;
+
+        root.set_inline_depth(static_cast<std::size_t>(state.range(0)));
+
+        while (state.KeepRunning()) {
+            for (std::size_t i = 0; i < STEPS; ++i) {
+                root.add([&](IAsyncSteps& asi) { asi(1); });
+                root.add([&](IAsyncSteps&, int v) { acc += v; });
+            }
+
+            root.execute();
+            reactor.run();
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(asyncsteps_sequence)->Arg(0)->Arg(16); // NOLINT
+
+    void asyncsteps_repeat(benchmark::State& state)
+    {
+        Reactor reactor;
+        AsyncSteps root(reactor);
+        std::size_t acc = 0;
+
+        while (state.KeepRunning()) {
+            root.repeat(STEPS, [&](IAsyncSteps&, std::size_t i) { acc += i; });
+            root.execute();
+            reactor.run();
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(asyncsteps_repeat); // NOLINT
+
+    void asyncsteps_parallel(benchmark::State& state)
+    {
+        Reactor reactor;
+        AsyncSteps root(reactor);
+        std::size_t acc = 0;
+
+        while (state.KeepRunning()) {
+            auto& p = root.parallel();
+
+            for (std::size_t i = 0; i < STEPS; ++i) {
+                p.add([&](IAsyncSteps&) { ++acc; });
+            }
+
+            root.execute();
+            reactor.run();
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(asyncsteps_parallel); // NOLINT
+
+    void asyncsteps_parallel_limit(benchmark::State& state)
+    {
+        Reactor reactor;
+        AsyncSteps root(reactor);
+        const auto limit = static_cast<std::size_t>(state.range(0));
+        std::size_t acc = 0;
+
+        while (state.KeepRunning()) {
+            auto& p = root.parallel({}, limit);
+
+            for (std::size_t i = 0; i < STEPS; ++i) {
+                p.add([&](IAsyncSteps&) { ++acc; });
+            }
+
+            root.execute();
+            reactor.run();
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(asyncsteps_parallel_limit)->Arg(1)->Arg(8); // NOLINT
+
+    void asyncsteps_for_each(benchmark::State& state)
+    {
+        Reactor reactor;
+        AsyncSteps root(reactor);
+        std::vector<std::size_t> values(STEPS * 16, 1);
+        std::size_t acc = 0;
+
+        while (state.KeepRunning()) {
+            root.forEach(
+                    std::ref(values),
+                    [&](IAsyncSteps&, std::size_t, std::size_t& v) {
+                        acc += v;
+                    });
+            root.execute();
+            reactor.run();
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(asyncsteps_for_each); // NOLINT
+
+    void asyncsteps_parallel_for_each(benchmark::State& state)
+    {
+        Reactor reactor;
+        AsyncSteps root(reactor);
+        std::vector<std::size_t> values(STEPS * 16, 1);
+        const auto chunk = static_cast<std::size_t>(state.range(0));
+        std::size_t acc = 0;
+
+        while (state.KeepRunning()) {
+            root.add([&](IAsyncSteps& asi) {
+                asi.parallelForEach(
+                        std::ref(values),
+                        [&](IAsyncSteps&, std::size_t, std::size_t& v) {
+                            acc += v;
+                        },
+                        4,
+                        chunk);
+            });
+            root.execute();
+            reactor.run();
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(asyncsteps_parallel_for_each)->Arg(1)->Arg(64); // NOLINT
+
+    std::size_t burn(std::size_t seed) noexcept
+    {
+        for (std::size_t i = 0; i < 100000; ++i) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+
+        return seed;
+    }
+
+    void asyncsteps_parallel_cpu(benchmark::State& state)
+    {
+        const auto mode = static_cast<IAsyncSteps::ParallelMode>(
+                state.range(0));
+        ReactorPool pool(0, [](IAsyncTool& tool) {
+            return std::unique_ptr<IAsyncSteps>(new AsyncSteps(tool));
+        });
+        Reactor reactor;
+        AsyncSteps root(reactor);
+        std::atomic<std::size_t> acc{0};
+
+        root.set_thread_pool(&pool);
+
+        while (state.KeepRunning()) {
+            auto& p = root.parallel({}, mode);
+
+            for (std::size_t i = 0; i < pool.size() * 2; ++i) {
+                p.add([&, i](IAsyncSteps&) { acc += burn(i); });
+            }
+
+            root.execute();
+
+            while (root.is_running()) {
+                reactor.run();
+                reactor.wait(std::chrono::milliseconds(1));
+            }
+        }
+
+        benchmark::DoNotOptimize(acc.load());
+    }
+    BENCHMARK(asyncsteps_parallel_cpu)->Arg(0)->Arg(1); // NOLINT
+} // namespace
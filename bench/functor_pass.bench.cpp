@@ -0,0 +1,94 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <futoin/details/erased_func.hpp>
+#include <futoin/details/functor_pass.hpp>
+
+using namespace futoin::details;
+
+namespace {
+    using Pass = functor_pass::Simple<
+            void(int),
+            functor_pass::DEFAULT_SIZE,
+            functor_pass::Function>;
+
+    void accept(Pass&& pass, Pass::Function& func, Pass::Storage& storage)
+    {
+        pass.move(func, storage);
+    }
+
+    void functor_pass_move(benchmark::State& state)
+    {
+        Pass::Storage storage;
+        Pass::Function func;
+        int acc = 0;
+
+        while (state.KeepRunning()) {
+            accept([&acc](int v) { acc += v; }, func, storage);
+            benchmark::DoNotOptimize(func);
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(functor_pass_move); // NOLINT
+
+    void function_call(benchmark::State& state)
+    {
+        int acc = 0;
+        auto lambda = [&acc](int v) { acc += v; };
+        functor_pass::Function<void(int)> func = std::ref(lambda);
+
+        while (state.KeepRunning()) {
+            func(1);
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(function_call); // NOLINT
+
+    void std_function_call(benchmark::State& state)
+    {
+        int acc = 0;
+        std::function<void(int)> func = [&acc](int v) { acc += v; };
+
+        while (state.KeepRunning()) {
+            func(1);
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(std_function_call); // NOLINT
+
+    void erased_func_repeatable(benchmark::State& state)
+    {
+        using ErasedFunc = futoin::details::ErasedFunc<>;
+
+        int acc = 0;
+        ErasedFunc func{
+                ErasedFunc::SimplePass<void(int)>([&acc](int v) { acc += v; })};
+        ErasedFunc::NextArgs args{1};
+
+        while (state.KeepRunning()) {
+            func.repeatable(args);
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(erased_func_repeatable); // NOLINT
+} // namespace
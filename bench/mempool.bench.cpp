@@ -0,0 +1,63 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <list>
+#include <memory>
+
+#include <futoin/imempool.hpp>
+#include <futoin/ri/slabmempool.hpp>
+
+using futoin::IMemPool;
+
+namespace {
+    template<typename Allocator>
+    void list_churn(
+            benchmark::State& state, const Allocator& allocator = Allocator())
+    {
+        std::list<int, Allocator> l(allocator);
+
+        while (state.KeepRunning()) {
+            for (int i = 0; i < 16; ++i) {
+                l.push_back(i);
+            }
+
+            l.clear();
+        }
+    }
+
+    void std_allocator(benchmark::State& state)
+    {
+        list_churn<std::allocator<int>>(state);
+    }
+    BENCHMARK(std_allocator); // NOLINT
+
+    void mem_pool_allocator(benchmark::State& state)
+    {
+        list_churn<IMemPool::Allocator<int>>(state);
+    }
+    BENCHMARK(mem_pool_allocator); // NOLINT
+
+    void slab_mem_pool_allocator(benchmark::State& state)
+    {
+        // Allocator<int> caches the default pool per thread
+        futoin::ri::SlabMemPool mem_pool;
+        list_churn(state, IMemPool::Allocator<int>(mem_pool));
+    }
+    BENCHMARK(slab_mem_pool_allocator); // NOLINT
+} // namespace
@@ -0,0 +1,74 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <futoin/details/functor_pass.hpp>
+#include <futoin/details/nextargs.hpp>
+#include <futoin/ri/asyncsteps.hpp>
+#include <futoin/ri/reactor.hpp>
+
+using futoin::IAsyncSteps;
+using futoin::details::functor_pass::Function;
+using futoin::details::nextargs::NextArgs;
+using futoin::ri::AsyncSteps;
+using futoin::ri::Reactor;
+
+namespace {
+    void next_args_assign(benchmark::State& state)
+    {
+        NextArgs args;
+        int i = 0;
+
+        while (state.KeepRunning()) {
+            args.assign(i++);
+            benchmark::DoNotOptimize(args);
+        }
+    }
+    BENCHMARK(next_args_assign); // NOLINT
+
+    void next_args_assign4(benchmark::State& state)
+    {
+        NextArgs args;
+        int i = 0;
+
+        while (state.KeepRunning()) {
+            args.assign(i++, 1.0, true, 'c');
+            benchmark::DoNotOptimize(args);
+        }
+    }
+    BENCHMARK(next_args_assign4); // NOLINT
+
+    void next_args_once(benchmark::State& state)
+    {
+        Reactor reactor;
+        AsyncSteps asi(reactor);
+
+        int acc = 0;
+        auto lambda = [&acc](IAsyncSteps&, int v, double) { acc += v; };
+        Function<void(IAsyncSteps&, int, double)> func = std::ref(lambda);
+        NextArgs args;
+
+        while (state.KeepRunning()) {
+            args.assign(1, 1.0);
+            args.once(asi, func);
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(next_args_once); // NOLINT
+} // namespace
@@ -0,0 +1,115 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <futoin/ri/reactor.hpp>
+
+using futoin::IAsyncTool;
+using futoin::ri::Reactor;
+
+namespace {
+    constexpr std::size_t FANOUT = 256;
+
+    struct Inc
+    {
+        std::size_t* acc;
+
+        void operator()() const
+        {
+            ++(*acc);
+        }
+    };
+
+    void reactor_immediate_loop(benchmark::State& state)
+    {
+        Reactor reactor;
+        IAsyncTool& tool = reactor;
+        std::size_t acc = 0;
+
+        while (state.KeepRunning()) {
+            for (std::size_t i = 0; i < FANOUT; ++i) {
+                tool.immediate(Inc{&acc});
+            }
+
+            tool.iterate();
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(reactor_immediate_loop); // NOLINT
+
+    void reactor_immediate_batch(benchmark::State& state)
+    {
+        Reactor reactor;
+        IAsyncTool& tool = reactor;
+        std::size_t acc = 0;
+        std::vector<Inc> fns(FANOUT, Inc{&acc});
+        std::vector<IAsyncTool::CallbackPass> cbs(FANOUT);
+
+        while (state.KeepRunning()) {
+            for (std::size_t i = 0; i < FANOUT; ++i) {
+                cbs[i] = IAsyncTool::CallbackPass(std::move(fns[i]));
+            }
+
+            tool.immediate_batch(cbs.data(), FANOUT);
+            tool.iterate();
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(reactor_immediate_batch); // NOLINT
+
+    void reactor_immediate_lanes(benchmark::State& state)
+    {
+        Reactor reactor;
+        IAsyncTool& tool = reactor;
+        std::size_t acc = 0;
+
+        while (state.KeepRunning()) {
+            for (std::size_t i = 0; i < FANOUT; ++i) {
+                auto prio = static_cast<IAsyncTool::Priority>(
+                        i % IAsyncTool::PRIORITY_COUNT);
+                tool.immediate_priority(prio, Inc{&acc});
+            }
+
+            tool.iterate();
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(reactor_immediate_lanes); // NOLINT
+
+    void reactor_handle_cancel(benchmark::State& state)
+    {
+        Reactor reactor;
+        IAsyncTool& tool = reactor;
+        std::size_t acc = 0;
+
+        while (state.KeepRunning()) {
+            auto h = tool.immediate(Inc{&acc});
+            benchmark::DoNotOptimize(static_cast<bool>(h));
+            h.cancel();
+            benchmark::DoNotOptimize(static_cast<bool>(h));
+        }
+
+        benchmark::DoNotOptimize(acc);
+    }
+    BENCHMARK(reactor_handle_cancel); // NOLINT
+} // namespace
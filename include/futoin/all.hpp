@@ -27,6 +27,13 @@
 #include "iasyncsteps.hpp"
 #include "iasynctool.hpp"
 #include "ispec.hpp"
+//---
+#include "ri/slabmempool.hpp"
+#include "ri/steparena.hpp"
+#include "ri/reactor.hpp"
+#include "ri/reactorpool.hpp"
+#include "ri/uringreactor.hpp"
+#include "ri/asyncsteps.hpp"
 
 /**
  * @brief Main namespace for FutoIn project
@@ -46,8 +46,57 @@
 #    include <exception>
 #endif
 
+/**
+ * @brief Size of futoin::any inline storage in pointers
+ *
+ * Larger values reduce spill of payloads into memory pool at cost of
+ * futoin::any footprint.
+ * @note It must be the same for all translation units.
+ */
+#ifndef FUTOIN_ANY_INLINE_PTRS
+#    define FUTOIN_ANY_INLINE_PTRS 8
+#endif
+
+#if !defined(FUTOIN_NO_RTTI) && (defined(__GXX_RTTI) || defined(_CPPRTTI))
+#    define FUTOIN_ANY_RTTI
+#endif
+
 namespace futoin {
 #ifdef FUTOIN_USING_OWN_ANY
+    /**
+     * @private
+     */
+    namespace details {
+        /**
+         * @brief Per-type unique tag of futoin::any payload
+         *
+         * Address of the tag is used as type ID, so type check is
+         * a single pointer compare with no RTTI calls.
+         */
+        struct AnyTypeTag
+        {
+#    ifdef FUTOIN_ANY_RTTI
+            const std::type_info* info;
+#    else
+            char unused;
+#    endif
+        };
+
+        template<typename T>
+        struct AnyTypeId
+        {
+            static AnyTypeTag tag;
+        };
+
+        template<typename T>
+#    ifdef FUTOIN_ANY_RTTI
+        AnyTypeTag AnyTypeId<T>::tag{&typeid(T)};
+#    else
+        AnyTypeTag AnyTypeId<T>::tag{0};
+#    endif
+    } // namespace details
+
+#    ifdef FUTOIN_ANY_RTTI
     static inline futoin::string demangle(const std::type_info& ti)
     {
 #    ifdef __GNUC__
@@ -66,10 +115,29 @@ namespace futoin {
     {
         std::cerr << "[ERROR] bad any cast: " << demangle(src) << " -> "
                   << demangle(dst) << std::endl;
-#    ifdef FUTOIN_NO_EXC
+#        ifdef FUTOIN_NO_EXC
         std::terminate();
+#        else
+        throw std::bad_cast();
+#        endif
+    }
+#    endif
+
+    [[noreturn]] inline void throw_bad_cast(
+            const details::AnyTypeTag* src, const details::AnyTypeTag& dst)
+    {
+#    ifdef FUTOIN_ANY_RTTI
+        throw_bad_cast(
+                (src != nullptr) ? *(src->info) : typeid(void), *(dst.info));
 #    else
+        (void) src;
+        (void) dst;
+        std::cerr << "[ERROR] bad any cast" << std::endl;
+#        ifdef FUTOIN_NO_EXC
+        std::terminate();
+#        else
         throw std::bad_cast();
+#        endif
 #    endif
     }
 
@@ -79,19 +147,19 @@ namespace futoin {
     class any
     {
     public:
-        any() noexcept : type_info_(void_info_), control_(default_control) {}
+        any() noexcept : control_(default_control) {}
 
         any(const any& other)
         {
-            type_info_ = other.type_info_;
+            type_ = other.type_;
             (control_ = other.control_)(Copy, const_cast<any&>(other), *this);
         }
 
         any(any&& other) noexcept
         {
-            type_info_ = other.type_info_;
+            type_ = other.type_;
             (control_ = other.control_)(Move, other, *this);
-            other.type_info_ = void_info_;
+            other.type_ = nullptr;
             other.control_ = default_control;
         }
 
@@ -100,10 +168,11 @@ namespace futoin {
                 typename D = typename std::
                         enable_if<!std::is_same<T, any>::value, void>::type>
         // NOLINTNEXTLINE(misc-forwarding-reference-overload)
-        explicit any(T&& v) noexcept : type_info_(&typeid(T))
+        explicit any(T&& v) noexcept
         {
             using U = typename std::remove_cv<
                     typename std::remove_reference<T>::type>::type;
+            type_ = &details::AnyTypeId<U>::tag;
             Accessor<U>::set(*this, std::forward<U>(v));
         }
 
@@ -111,10 +180,11 @@ namespace futoin {
                 class T,
                 typename D = typename std::
                         enable_if<!std::is_same<T, any>::value, void>::type>
-        explicit any(const T& v) noexcept : type_info_(&typeid(T))
+        explicit any(const T& v) noexcept
         {
             using U = typename std::remove_cv<
                     typename std::remove_reference<T>::type>::type;
+            type_ = &details::AnyTypeId<U>::tag;
             Accessor<U>::set(*this, v);
         }
 
@@ -127,9 +197,9 @@ namespace futoin {
         {
             if (&other != this) {
                 control_(Cleanup, *this, *this);
-                type_info_ = other.type_info_;
+                type_ = other.type_;
                 (control_ = other.control_)(Move, other, *this);
-                other.type_info_ = void_info_;
+                other.type_ = nullptr;
                 other.control_ = default_control;
             }
 
@@ -140,7 +210,7 @@ namespace futoin {
         {
             if (&other != this) {
                 control_(Cleanup, *this, *this);
-                type_info_ = other.type_info_;
+                type_ = other.type_;
                 (control_ = other.control_)(
                         Copy, const_cast<any&>(other), *this);
             }
@@ -157,9 +227,13 @@ namespace futoin {
             using U = typename std::remove_cv<
                     typename std::remove_reference<T>::type>::type;
 
+            if (reassign<U>(v, is_trivial_value<U>())) {
+                return *this;
+            }
+
             control_(Cleanup, *this, *this);
 
-            type_info_ = &typeid(U);
+            type_ = &details::AnyTypeId<U>::tag;
             Accessor<U>::set(*this, std::forward<U>(v));
 
             return *this;
@@ -174,9 +248,13 @@ namespace futoin {
             using U = typename std::remove_cv<
                     typename std::remove_reference<T>::type>::type;
 
+            if (reassign<U>(v, is_trivial_value<U>())) {
+                return *this;
+            }
+
             control_(Cleanup, *this, *this);
 
-            type_info_ = &typeid(U);
+            type_ = &details::AnyTypeId<U>::tag;
             Accessor<U>::set(*this, v);
 
             return *this;
@@ -186,7 +264,7 @@ namespace futoin {
         {
             control_(Cleanup, *this, *this);
 
-            type_info_ = void_info_;
+            type_ = nullptr;
             control_ = default_control;
         }
 
@@ -194,13 +272,15 @@ namespace futoin {
 
         bool has_value() const noexcept
         {
-            return type_info_->hash_code() != void_info_->hash_code();
+            return type_ != nullptr;
         }
 
+#    ifdef FUTOIN_ANY_RTTI
         const std::type_info& type() const noexcept
         {
-            return *type_info_;
+            return (type_ != nullptr) ? *(type_->info) : typeid(void);
         }
+#    endif
 
         void extract(FutoInBinaryValue& v)
         {
@@ -217,15 +297,45 @@ namespace futoin {
         };
         using ControlHandler = void(ControlMode, any&, any&);
 
-        const std::type_info* type_info_;
+        const details::AnyTypeTag* type_{nullptr};
         ControlHandler* control_;
-        // NOLINTNEXTLINE(readability-magic-numbers)
-        std::array<void*, 8> data_;
+        std::array<void*, FUTOIN_ANY_INLINE_PTRS> data_;
+
+        static_assert(
+                FUTOIN_ANY_INLINE_PTRS >= 2,
+                "Inline storage must fit large object pointers");
 
-        static constexpr const std::type_info* void_info_ = &typeid(void);
         // NOLINTNEXTLINE(readability-named-parameter)
         static void default_control(ControlMode, any&, any&) noexcept {}
 
+        template<typename T>
+        using is_trivial_value = std::integral_constant<
+                bool,
+                (std::is_fundamental<T>::value || std::is_pointer<T>::value)
+                        && (sizeof(T) <= sizeof(data_))>;
+
+        /**
+         * @brief Overwrite value of the same fundamental type in-place
+         * @return false, if full reset is required
+         */
+        template<typename T>
+        inline bool reassign(const T& v, std::true_type /*trivial*/) noexcept
+        {
+            if (type_ == &details::AnyTypeId<T>::tag) {
+                *reinterpret_cast<T*>((void*) data_.data()) = v;
+                return true;
+            }
+
+            return false;
+        }
+
+        template<typename T>
+        inline bool reassign(
+                const T& /*v*/, std::false_type /*trivial*/) const noexcept
+        {
+            return false;
+        }
+
         /**
          * @private
          */
@@ -237,6 +347,31 @@ namespace futoin {
         struct Accessor
         {};
 
+        /**
+         * @brief Check payload type
+         * @note Type tags may be duplicated across shared objects,
+         *       so RTTI is used on mismatch, if available.
+         */
+        template<typename T>
+        inline bool is_type() const noexcept
+        {
+            auto* tag = &details::AnyTypeId<T>::tag;
+            return (type_ == tag) || same_type(type_, tag);
+        }
+
+        static bool same_type(
+                const details::AnyTypeTag* a,
+                const details::AnyTypeTag* b) noexcept
+        {
+#    ifdef FUTOIN_ANY_RTTI
+            return (a != nullptr) && (*(a->info) == *(b->info));
+#    else
+            (void) a;
+            (void) b;
+            return false;
+#    endif
+        }
+
         template<class T>
         friend inline const T* any_cast(const any* that)
         {
@@ -266,8 +401,13 @@ namespace futoin {
                 new_copy(void* p, const T& other)
         {
             (void) p;
+#    ifdef FUTOIN_ANY_RTTI
             std::cerr << "[ERROR] no copy c-tor: " << demangle(typeid(other))
                       << std::endl;
+#    else
+            (void) other;
+            std::cerr << "[ERROR] no copy c-tor" << std::endl;
+#    endif
 #    ifdef FUTOIN_NO_EXC
             std::terminate();
 #    else
@@ -316,11 +456,11 @@ namespace futoin {
 
         static T* get(any& that)
         {
-            if (that.type_info_->hash_code() == typeid(T).hash_code()) {
+            if (that.is_type<T>()) {
                 return reinterpret_cast<T*>((void*) that.data_.data());
             }
 
-            throw_bad_cast(*(that.type_info_), typeid(T));
+            throw_bad_cast(that.type_, details::AnyTypeId<T>::tag);
         }
     };
 
@@ -364,11 +504,11 @@ namespace futoin {
 
         static T* get(any& that)
         {
-            if (that.type_info_->hash_code() == typeid(T).hash_code()) {
+            if (that.is_type<T>()) {
                 return reinterpret_cast<T*>(that.data_.data());
             }
 
-            throw_bad_cast(*(that.type_info_), typeid(T));
+            throw_bad_cast(that.type_, details::AnyTypeId<T>::tag);
         }
     };
 
@@ -380,7 +520,8 @@ namespace futoin {
     {
         static inline void set(any& that, T&& v) noexcept
         {
-            auto& mem_pool = GlobalMemPool::get_default();
+            auto& mem_pool =
+                    GlobalMemPool::get_default().mem_pool(sizeof(T), true);
             auto* p = mem_pool.allocate(sizeof(T), 1);
             new (p) T(std::forward<T>(v));
             that.data_[0] = p;
@@ -425,11 +566,11 @@ namespace futoin {
 
         static T* get(any& that)
         {
-            if (that.type_info_->hash_code() == typeid(T).hash_code()) {
+            if (that.is_type<T>()) {
                 return reinterpret_cast<T*>(that.data_[0]);
             }
 
-            throw_bad_cast(*(that.type_info_), typeid(T));
+            throw_bad_cast(that.type_, details::AnyTypeId<T>::tag);
         }
     };
 
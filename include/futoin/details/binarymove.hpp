@@ -22,10 +22,12 @@
 #ifndef FUTOIN_DETAILS_BINARYMOVE_HPP
 #define FUTOIN_DETAILS_BINARYMOVE_HPP
 
+#include <new>
 #include <vector>
 // ---
 #include "../binaryval.h"
 #include "../fatalmsg.hpp"
+#include "../imempool.hpp"
 #include "../string.hpp"
 // ---
 
@@ -37,15 +39,70 @@ namespace futoin {
         template<typename T, typename Any>
         struct moveHelper;
 
+        /**
+         * @brief Payload owned through FutoInBinaryValue::custom_data
+         *
+         * It's allocated from the thread default IMemPool and gets back
+         * to the same pool on cleanup, even if done by other thread.
+         */
+        template<typename T>
+        struct BinaryHolder
+        {
+            template<typename... Args>
+            BinaryHolder(IMemPool& mem_pool, Args&&... args) :
+                value(std::forward<Args>(args)...), mem_pool(mem_pool)
+            {}
+
+            static IMemPool& default_pool() noexcept
+            {
+                return GlobalMemPool::get_default().mem_pool(
+                        sizeof(BinaryHolder), true);
+            }
+
+            template<typename... Args>
+            static BinaryHolder* create(Args&&... args)
+            {
+                auto& mem_pool = default_pool();
+                return new (mem_pool.allocate(sizeof(BinaryHolder), 1))
+                        BinaryHolder(mem_pool, std::forward<Args>(args)...);
+            }
+
+            static void destroy(void* ptr) noexcept
+            {
+                auto* h = reinterpret_cast<BinaryHolder*>(ptr);
+                auto& mem_pool = h->mem_pool;
+
+                if (h->extra != nullptr) {
+                    mem_pool.deallocate(h->extra, 1, h->extra_size);
+                }
+
+                h->~BinaryHolder();
+                mem_pool.deallocate(h, sizeof(BinaryHolder), 1);
+            }
+
+            static T& get(const FutoInBinaryValue& d) noexcept
+            {
+                return reinterpret_cast<BinaryHolder*>(d.custom_data)->value;
+            }
+
+            T value;
+            IMemPool& mem_pool;
+            //! Optional side buffer from the same pool, e.g. packed bools
+            void* extra{nullptr};
+            std::size_t extra_size{0};
+        };
+
         // String helpers
         // ---
         template<typename T, FutoInTypeFlags FT>
         struct moveStringHelper
         {
+            using Holder = BinaryHolder<T>;
+
             // constexpr lambdas are C++17 :(
             static void cleanup(FutoInBinaryValue* v)
             {
-                delete reinterpret_cast<T*>(v->custom_data);
+                Holder::destroy(v->custom_data);
             }
 
             static constexpr FutoInType FTN_TYPE = {FT, &cleanup};
@@ -53,18 +110,19 @@ namespace futoin {
             template<typename Any>
             static void moveTo(FutoInBinaryValue& d, Any&& /*a*/, T&& v)
             {
-                auto* s = new T(std::move(v));
-                d.custom_data = s;
-                d.p = s->data();
-                d.length = s->length();
+                auto* h = Holder::create(std::move(v));
+                d.custom_data = h;
+                d.p = h->value.data();
+                d.length = h->value.length();
                 d.type = &FTN_TYPE;
             }
             template<typename Any>
             static void moveFrom(FutoInBinaryValue& d, Any& a)
             {
                 if (d.type == &FTN_TYPE) {
-                    a = std::move(*reinterpret_cast<T*>(d.custom_data));
+                    a = std::move(Holder::get(d));
                 } else {
+                    // Foreign producer owns the buffer, so copy
                     a = T{reinterpret_cast<const typename T::value_type*>(d.p)};
                 }
             }
@@ -175,9 +233,11 @@ namespace futoin {
         template<typename T, typename Any>
         struct moveObjectHelper
         {
+            using Holder = BinaryHolder<Any>;
+
             static void cleanup(FutoInBinaryValue* v)
             {
-                delete reinterpret_cast<Any*>(v->custom_data);
+                Holder::destroy(v->custom_data);
             }
             static constexpr FutoInType FTN_TYPE = {
                     FTN_TYPE_CUSTOM_OBJECT, &cleanup};
@@ -185,7 +245,7 @@ namespace futoin {
             static void moveFrom(FutoInBinaryValue& d, Any& a)
             {
                 if (d.type == &FTN_TYPE) {
-                    a = std::move(*reinterpret_cast<Any*>(d.custom_data));
+                    a = std::move(Holder::get(d));
                 }
             }
         };
@@ -195,10 +255,15 @@ namespace futoin {
         template<typename T, typename Any>
         struct moveHelper : moveObjectHelper<const void*, Any>
         {
-            static void moveTo(FutoInBinaryValue& d, Any&& /*a*/, T&& v)
+            /**
+             * @note The whole source any is moved to skip re-allocation
+             *       of large objects.
+             */
+            static void moveTo(FutoInBinaryValue& d, Any&& a, T&& /*v*/)
             {
                 d.type = &moveHelper<const void*, Any>::FTN_TYPE;
-                d.custom_data = new Any{std::forward<T>(v)};
+                d.custom_data = moveHelper<const void*, Any>::Holder::create(
+                        std::move(a));
             }
         };
 
@@ -211,26 +276,32 @@ namespace futoin {
                 typename Any>
         struct moveArrayHelper
         {
+            using Holder = BinaryHolder<Any>;
+
             static void cleanup(FutoInBinaryValue* v)
             {
-                delete reinterpret_cast<Any*>(v->custom_data);
+                Holder::destroy(v->custom_data);
             }
             static constexpr FutoInType FTN_TYPE = {
                     FTN_TYPE_ARRAY | FT, &cleanup};
             using Vector = std::vector<T, Allocator>;
 
-            static void moveTo(FutoInBinaryValue& d, Any&& /*a*/, Vector&& v)
+            /**
+             * @note Vector buffer is not reallocated on move, so data
+             *       pointer stays valid after the whole any is moved.
+             */
+            static void moveTo(FutoInBinaryValue& d, Any&& a, Vector&& v)
             {
                 d.p = v.data();
                 d.length = v.size();
                 d.type = &moveHelper<const void*, Any>::FTN_TYPE;
-                d.custom_data = new Any{std::forward<Vector>(v)};
+                d.custom_data = Holder::create(std::move(a));
             }
 
             static void moveFrom(FutoInBinaryValue& d, Any& a)
             {
                 if (d.type == &FTN_TYPE) {
-                    a = std::move(*reinterpret_cast<Any*>(d.custom_data));
+                    a = std::move(Holder::get(d));
                 } else {
                     T* p = reinterpret_cast<T*>(const_cast<void*>(d.p));
                     a = Any{Vector{p, p + d.length}};
@@ -247,10 +318,11 @@ namespace futoin {
         template<FutoInTypeFlags FT, typename Allocator, typename Any>
         struct moveArrayHelper<bool, FT, Allocator, Any>
         {
+            using Holder = BinaryHolder<Any>;
+
             static void cleanup(FutoInBinaryValue* v)
             {
-                delete[] reinterpret_cast<bool*>(const_cast<void*>(v->p));
-                delete reinterpret_cast<Any*>(v->custom_data);
+                Holder::destroy(v->custom_data);
             }
             static constexpr FutoInType FTN_TYPE = {
                     FTN_TYPE_ARRAY | FT,
@@ -258,10 +330,11 @@ namespace futoin {
             };
             using Vector = std::vector<bool, Allocator>;
 
-            static void moveTo(FutoInBinaryValue& d, Any&& /*a*/, Vector&& v)
+            static void moveTo(FutoInBinaryValue& d, Any&& a, Vector&& v)
             {
                 auto size = v.size();
-                auto* p = new bool[size];
+                auto* p = reinterpret_cast<bool*>(
+                        Holder::default_pool().allocate(sizeof(bool), size));
                 d.p = p;
                 d.length = size;
 
@@ -269,14 +342,18 @@ namespace futoin {
                     *(p++) = b;
                 }
 
+                auto* h = Holder::create(std::move(a));
+                h->extra = const_cast<void*>(d.p);
+                h->extra_size = sizeof(bool) * size;
+
                 d.type = &moveHelper<const void*, Any>::FTN_TYPE;
-                d.custom_data = new Any{std::forward<Vector>(v)};
+                d.custom_data = h;
             }
 
             static void moveFrom(FutoInBinaryValue& d, Any& a)
             {
                 if (d.type == &FTN_TYPE) {
-                    a = std::move(*reinterpret_cast<Any*>(d.custom_data));
+                    a = std::move(Holder::get(d));
                 } else {
                     bool* p = reinterpret_cast<bool*>(const_cast<void*>(d.p));
                     a = Any{Vector(p, (p + d.length))};
@@ -73,6 +73,10 @@ namespace futoin {
 
             /**
              * @internal
+             *
+             * Only the first size() slots are used. Slots past it are left
+             * empty, so assign() constructs and destroys only what is
+             * actually passed.
              */
             struct NextArgs : public std::array<any, MAX_NEXT_ARGS>
             {
@@ -87,19 +91,31 @@ namespace futoin {
                     assign(std::forward<T>(args)...);
                 }
 
-                template<
-                        typename A = NoArg,
-                        typename B = NoArg,
-                        typename C = NoArg,
-                        typename D = NoArg>
-                inline void assign(
-                        A&& a = {}, B&& b = {}, C&& c = {}, D&& d = {}) noexcept
+                template<typename... T>
+                inline void assign(T&&... args) noexcept
                 {
+                    static_assert(
+                            sizeof...(T) <= MAX_NEXT_ARGS,
+                            "Too many arguments");
+
+                    std::size_t count = 0;
+                    set_args(count, 0, std::forward<T>(args)...);
+
                     auto* p = data();
-                    *p = any(smart_forward<A>::it(a));
-                    *(p + 1) = any(smart_forward<B>::it(b));
-                    *(p + 2) = any(smart_forward<C>::it(c));
-                    *(p + 3) = any(smart_forward<D>::it(d));
+
+                    for (auto i = count; i < count_; ++i) {
+                        (p + i)->reset();
+                    }
+
+                    count_ = count;
+                }
+
+                /**
+                 * @brief Number of used argument slots
+                 */
+                inline std::size_t size() const noexcept
+                {
+                    return count_;
                 }
 
                 // Moving calls
@@ -179,19 +195,24 @@ namespace futoin {
                 inline void moveTo(FutoInArgs& args)
                 {
                     auto* p = data();
-                    p->extract(args.arg0);
-                    (p + 1)->extract(args.arg1);
-                    (p + 2)->extract(args.arg2);
-                    (p + 3)->extract(args.arg3);
+
+                    switch (count_) {
+                    case 4: (p + 3)->extract(args.arg3); // fall through
+                    case 3: (p + 2)->extract(args.arg2); // fall through
+                    case 2: (p + 1)->extract(args.arg1); // fall through
+                    case 1: p->extract(args.arg0); // fall through
+                    default: break;
+                    }
                 }
 
                 inline void moveFrom(FutoInArgs& args)
                 {
-                    auto* p = data();
-                    details::moveFrom(args.arg0, *p);
-                    details::moveFrom(args.arg1, *(p + 1));
-                    details::moveFrom(args.arg2, *(p + 2));
-                    details::moveFrom(args.arg3, *(p + 3));
+                    std::size_t count = 0;
+                    move_arg(count, 0, args.arg0);
+                    move_arg(count, 1, args.arg1);
+                    move_arg(count, 2, args.arg2);
+                    move_arg(count, 3, args.arg3);
+                    count_ = count;
                 }
 
                 // Const calls
@@ -315,6 +336,68 @@ namespace futoin {
                         typename C = NoArg,
                         typename D = NoArg>
                 struct Model;
+
+            private:
+                inline void move_arg(
+                        std::size_t& count,
+                        std::size_t index,
+                        FutoInBinaryValue& v)
+                {
+                    auto* p = data() + index;
+
+                    if (v.type != nullptr) {
+                        details::moveFrom(v, *p);
+                    } else if (index < count_) {
+                        p->reset();
+                    }
+
+                    if (p->has_value()) {
+                        count = index + 1;
+                    }
+                }
+
+                inline void set_args(
+                        std::size_t& /*count*/, std::size_t /*index*/) noexcept
+                {}
+
+                template<typename A, typename... T>
+                inline void set_args(
+                        std::size_t& count,
+                        std::size_t index,
+                        A&& a,
+                        T&&... rest) noexcept
+                {
+                    set_arg(count,
+                            index,
+                            std::forward<A>(a),
+                            std::is_same<rem_constref<A>, NoArg>());
+                    set_args(count, index + 1, std::forward<T>(rest)...);
+                }
+
+                template<typename A>
+                inline void set_arg(
+                        std::size_t& /*count*/,
+                        std::size_t index,
+                        A&& /*a*/,
+                        std::true_type /*is_noarg*/) noexcept
+                {
+                    if (index < count_) {
+                        (data() + index)->reset();
+                    }
+                }
+
+                template<typename A>
+                inline void set_arg(
+                        std::size_t& count,
+                        std::size_t index,
+                        A&& a,
+                        std::false_type /*is_noarg*/) noexcept
+                {
+                    *(data() + index) = smart_forward<A>::it(a);
+                    count = index + 1;
+                }
+
+                std::size_t count_{0};
             };
 
             template<typename A, typename B, typename C, typename D>
@@ -26,11 +26,15 @@
 #include "details/reqcpp11.hpp"
 //---
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <future>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <thread>
@@ -89,6 +93,16 @@ namespace futoin {
                 functor_pass::Function>;
         using AwaitCallback = AwaitPass::Function;
 
+        /**
+         * @brief Execution mode of parallel() sub-steps
+         * @note Pseudo interleaves sub-steps on the same IAsyncTool.
+         */
+        enum class ParallelMode : std::uint8_t
+        {
+            Pseudo,
+            Threads,
+        };
+
         //---
         using ReferenceStateMap = std::map<futoin::string, any>;
         using StateMap = std::map<
@@ -97,6 +111,114 @@ namespace futoin {
                 ReferenceStateMap::key_compare,
                 IMemPool::Allocator<ReferenceStateMap::value_type>>;
 
+        /**
+         * @private
+         */
+        namespace state_key_hash {
+            constexpr std::uint64_t FNV_BASIS = 14695981039346656037ULL;
+            constexpr std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+            constexpr std::uint64_t fnv1a(
+                    const char* s, std::size_t len, std::uint64_t h) noexcept
+            {
+                return (len == 0) ? h
+                                  : fnv1a(s + 1,
+                                          len - 1,
+                                          (h ^ static_cast<unsigned char>(*s))
+                                                  * FNV_PRIME);
+            }
+
+            constexpr std::size_t length(
+                    const char* s, std::size_t max) noexcept
+            {
+                return ((max == 0) || (*s == '\0')) ? 0
+                                                     : 1 + length(s + 1, max - 1);
+            }
+
+            inline std::size_t runtime(const char* s, std::size_t len) noexcept
+            {
+                std::uint64_t h = FNV_BASIS;
+
+                for (; len > 0; --len, ++s) {
+                    h = (h ^ static_cast<unsigned char>(*s)) * FNV_PRIME;
+                }
+
+                return static_cast<std::size_t>(h);
+            }
+        } // namespace state_key_hash
+
+        /**
+         * @brief State key with hash calculated at compile time
+         *
+         * String literals passed to state() are implicitly converted, but
+         * then the hash is calculated at compile time only if the optimizer
+         * folds it. Declare static constexpr keys in advance to be sure.
+         * @note The name is copied on first insert.
+         */
+        struct HashedKey
+        {
+            template<std::size_t N>
+            // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+            constexpr HashedKey(const char (&name)[N]) noexcept :
+                name(name),
+                length(state_key_hash::length(name, N)),
+                hash(static_cast<std::size_t>(state_key_hash::fnv1a(
+                        name,
+                        state_key_hash::length(name, N),
+                        state_key_hash::FNV_BASIS)))
+            {}
+
+            const char* const name;
+            const std::size_t length;
+            const std::size_t hash;
+        };
+
+        /**
+         * @private
+         */
+        struct StateKeyBase
+        {
+            static std::size_t next_index() noexcept
+            {
+                static std::atomic<std::size_t> counter{0};
+                return counter.fetch_add(1, std::memory_order_relaxed);
+            }
+        };
+
+        /**
+         * @brief Typed state key resolved to a fixed slot index
+         *
+         * Access through BaseState::slot() returns T& without any_cast
+         * and map lookup.
+         * @note Keys must have static storage duration. Each instance takes
+         *       a process-wide slot index which is never reused, so every
+         *       state which touches the key grows its slot table up to it.
+         * @note T must not be over-aligned as slots come from IMemPool.
+         */
+        template<typename T>
+        class StateKey
+        {
+            static_assert(
+                    alignof(T) <= alignof(std::max_align_t),
+                    "Over-aligned types are not supported in state slots");
+
+        public:
+            using value_type = T;
+
+            StateKey() noexcept : index_(StateKeyBase::next_index()) {}
+
+            StateKey(const StateKey&) = delete;
+            StateKey& operator=(const StateKey&) = delete;
+
+            inline std::size_t index() const noexcept
+            {
+                return index_;
+            }
+
+        private:
+            const std::size_t index_;
+        };
+
         class BaseState
         {
         public:
@@ -104,6 +226,26 @@ namespace futoin {
                 mem_pool_(mem_pool)
             {}
 
+            BaseState(const BaseState&) = delete;
+            BaseState& operator=(const BaseState&) = delete;
+            BaseState(BaseState&&) = delete;
+            BaseState& operator=(BaseState&&) = delete;
+
+            virtual ~BaseState() noexcept
+            {
+                for (std::size_t i = 0; i < slot_count_; ++i) {
+                    auto& s = slots_[i];
+
+                    if (s.ptr != nullptr) {
+                        s.destroy(s.ptr, mem_pool_);
+                    }
+                }
+
+                if (slots_ != nullptr) {
+                    mem_pool_.deallocate(slots_, sizeof(Slot), slot_count_);
+                }
+            }
+
             using key_type = StateMap::key_type;
             using mapped_type = StateMap::mapped_type;
             using CatchTrace =
@@ -113,11 +255,87 @@ namespace futoin {
             virtual mapped_type& operator[](const key_type& key) noexcept = 0;
             virtual mapped_type& operator[](key_type&& key) noexcept = 0;
 
+            /**
+             * @brief Access by pre-hashed key
+             * @note Default implementation falls back to key_type.
+             */
+            virtual mapped_type& operator[](const HashedKey& key) noexcept
+            {
+                return (*this)[key_type(
+                        key.name,
+                        key.length,
+                        key_type::allocator_type(mem_pool_))];
+            }
+
+            template<std::size_t N>
+            // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+            mapped_type& operator[](const char (&key)[N]) noexcept
+            {
+                return (*this)[HashedKey(key)];
+            }
+
+            /**
+             * @brief Access typed slot, default constructed on first use
+             */
+            template<typename T>
+            T& slot(const StateKey<T>& key)
+            {
+                auto& s = get_slot(key.index());
+
+                if (s.ptr == nullptr) {
+                    s.ptr = new (mem_pool_.allocate(sizeof(T), 1)) T();
+                    s.destroy = &destroy_slot<T>;
+                }
+
+                return *static_cast<T*>(s.ptr);
+            }
+
+            /**
+             * @brief Access typed slot, initialized with def_val on first use
+             */
+            template<typename T, typename V>
+            T& slot(const StateKey<T>& key, V&& def_val)
+            {
+                auto& s = get_slot(key.index());
+
+                if (s.ptr == nullptr) {
+                    s.ptr = new (mem_pool_.allocate(sizeof(T), 1))
+                            T(std::forward<V>(def_val));
+                    s.destroy = &destroy_slot<T>;
+                }
+
+                return *static_cast<T*>(s.ptr);
+            }
+
+            /**
+             * @brief Check if typed slot is initialized
+             */
+            template<typename T>
+            bool has_slot(const StateKey<T>& key) const noexcept
+            {
+                auto index = key.index();
+                return (index < slot_count_) && (slots_[index].ptr != nullptr);
+            }
+
             inline IMemPool& mem_pool() const noexcept
             {
                 return mem_pool_;
             }
 
+            /**
+             * @brief Priority lane of immediate callbacks of the root
+             * @note Inherited by all steps of the same root.
+             */
+            inline IAsyncTool::Priority priority() const noexcept
+            {
+                return priority_;
+            }
+
+            inline void set_priority(IAsyncTool::Priority prio) noexcept
+            {
+                priority_ = prio;
+            }
+
             virtual const ErrorMessage& error_info() const noexcept = 0;
             virtual const std::exception_ptr& last_exception()
                     const noexcept = 0;
@@ -128,17 +346,81 @@ namespace futoin {
             virtual void set_unhandled_error(UnhandledError&&) noexcept = 0;
 
         private:
+            /**
+             * @private
+             */
+            struct Slot
+            {
+                void* ptr;
+                void (*destroy)(void*, IMemPool&) noexcept;
+            };
+
+            static constexpr std::size_t MIN_SLOT_COUNT = 8;
+
+            template<typename T>
+            static void destroy_slot(void* ptr, IMemPool& mem_pool) noexcept
+            {
+                static_cast<T*>(ptr)->~T();
+                mem_pool.deallocate(ptr, sizeof(T), 1);
+            }
+
+            inline Slot& get_slot(std::size_t index) noexcept
+            {
+                if (index >= slot_count_) {
+                    grow_slots(index);
+                }
+
+                return slots_[index];
+            }
+
+            void grow_slots(std::size_t index) noexcept
+            {
+                std::size_t count = slot_count_ * 2;
+
+                if (count <= index) {
+                    count = index + 1;
+                }
+
+                if (count < MIN_SLOT_COUNT) {
+                    count = MIN_SLOT_COUNT;
+                }
+
+                auto* slots = static_cast<Slot*>(
+                        mem_pool_.allocate(sizeof(Slot), count));
+                std::size_t i = 0;
+
+                for (; i < slot_count_; ++i) {
+                    slots[i] = slots_[i];
+                }
+
+                for (; i < count; ++i) {
+                    slots[i].ptr = nullptr;
+                }
+
+                if (slots_ != nullptr) {
+                    mem_pool_.deallocate(slots_, sizeof(Slot), slot_count_);
+                }
+
+                slots_ = slots;
+                slot_count_ = count;
+            }
+
             IMemPool& mem_pool_;
+            Slot* slots_{nullptr};
+            std::size_t slot_count_{0};
+            IAsyncTool::Priority priority_{IAsyncTool::Priority::Normal};
 
             friend class futoin::IAsyncSteps;
         };
 
-        class State : public BaseState
+        /**
+         * @brief Common error handling part of reference State objects
+         */
+        class CommonState : public BaseState
         {
         public:
-            explicit State(IMemPool& mem_pool) noexcept :
+            explicit CommonState(IMemPool& mem_pool) noexcept :
                 BaseState(mem_pool),
-                dynamic_items{StateMap::allocator_type(mem_pool)},
                 catch_trace_{[&](const std::exception& /*e*/) noexcept {
                     last_exception_ = std::current_exception();
                 }},
@@ -147,16 +429,6 @@ namespace futoin {
                 }}
             {}
 
-            mapped_type& operator[](const key_type& key) noexcept override
-            {
-                return dynamic_items[key];
-            }
-
-            mapped_type& operator[](key_type&& key) noexcept override
-            {
-                return dynamic_items[std::forward<key_type>(key)];
-            }
-
             const ErrorMessage& error_info() const noexcept final
             {
                 return error_info_;
@@ -190,13 +462,216 @@ namespace futoin {
             }
 
         private:
-            StateMap dynamic_items;
             ErrorMessage error_info_;
             std::exception_ptr last_exception_;
             CatchTrace catch_trace_;
             UnhandledError unhandled_error_;
         };
 
+        /**
+         * @brief Reference State with std::map-like dynamic items
+         */
+        class State : public CommonState
+        {
+        public:
+            explicit State(IMemPool& mem_pool) noexcept :
+                CommonState(mem_pool),
+                dynamic_items{StateMap::allocator_type(mem_pool)}
+            {}
+
+            using BaseState::operator[];
+
+            mapped_type& operator[](const key_type& key) noexcept override
+            {
+                return dynamic_items[key];
+            }
+
+            mapped_type& operator[](key_type&& key) noexcept override
+            {
+                return dynamic_items[std::forward<key_type>(key)];
+            }
+
+        private:
+            StateMap dynamic_items;
+        };
+
+        /**
+         * @brief Alternative State with open addressing hash table
+         *
+         * HashedKey access is a single hash probe with no allocation.
+         * Items are allocated as separate nodes to keep references valid
+         * on table growth, like with std::map.
+         */
+        class HashedState : public CommonState
+        {
+        public:
+            static constexpr std::size_t INITIAL_CAPACITY = 16;
+
+            explicit HashedState(IMemPool& mem_pool) noexcept :
+                CommonState(mem_pool)
+            {}
+
+            HashedState(const HashedState&) = delete;
+            HashedState& operator=(const HashedState&) = delete;
+            HashedState(HashedState&&) = delete;
+            HashedState& operator=(HashedState&&) = delete;
+
+            ~HashedState() noexcept
+            {
+                auto& mp = mem_pool();
+
+                for (std::size_t i = 0; i < capacity_; ++i) {
+                    auto* node = table_[i].node;
+
+                    if (node != nullptr) {
+                        node->~Node();
+                        mp.deallocate(node, sizeof(Node), 1);
+                    }
+                }
+
+                if (table_ != nullptr) {
+                    mp.deallocate(table_, sizeof(Slot), capacity_);
+                }
+            }
+
+            using BaseState::operator[];
+
+            mapped_type& operator[](const key_type& key) noexcept override
+            {
+                return find_or_insert(
+                        key.data(),
+                        key.size(),
+                        state_key_hash::runtime(key.data(), key.size()));
+            }
+
+            mapped_type& operator[](key_type&& key) noexcept override
+            {
+                return find_or_insert(
+                        key.data(),
+                        key.size(),
+                        state_key_hash::runtime(key.data(), key.size()));
+            }
+
+            mapped_type& operator[](const HashedKey& key) noexcept override
+            {
+                return find_or_insert(key.name, key.length, key.hash);
+            }
+
+            std::size_t size() const noexcept
+            {
+                return size_;
+            }
+
+        private:
+            /**
+             * @private
+             */
+            struct Node
+            {
+                Node(const char* name, std::size_t length, IMemPool& mem_pool) :
+                    name(name, length, key_type::allocator_type(mem_pool))
+                {}
+
+                key_type name;
+                mapped_type value;
+            };
+
+            /**
+             * @private
+             */
+            struct Slot
+            {
+                std::size_t hash;
+                Node* node;
+            };
+
+            mapped_type& find_or_insert(
+                    const char* name,
+                    std::size_t length,
+                    std::size_t hash) noexcept
+            {
+                Slot* slot = nullptr;
+
+                if (capacity_ != 0) {
+                    auto mask = capacity_ - 1;
+
+                    for (auto i = hash & mask;; i = (i + 1) & mask) {
+                        slot = &table_[i];
+                        auto* node = slot->node;
+
+                        if (node == nullptr) {
+                            break;
+                        }
+
+                        if ((slot->hash == hash)
+                            && (node->name.size() == length)
+                            && (std::memcmp(node->name.data(), name, length)
+                                == 0)) {
+                            return node->value;
+                        }
+                    }
+                }
+
+                // Lookup of existing items never grows
+                if ((size_ + 1) * 2 > capacity_) {
+                    grow();
+                    slot = &free_slot(hash);
+                }
+
+                auto& mp = mem_pool();
+                auto* node = new (mp.allocate(sizeof(Node), 1))
+                        Node(name, length, mp);
+                slot->hash = hash;
+                slot->node = node;
+                ++size_;
+                return node->value;
+            }
+
+            Slot& free_slot(std::size_t hash) noexcept
+            {
+                auto mask = capacity_ - 1;
+                auto i = hash & mask;
+
+                while (table_[i].node != nullptr) {
+                    i = (i + 1) & mask;
+                }
+
+                return table_[i];
+            }
+
+            void grow() noexcept
+            {
+                auto& mp = mem_pool();
+                auto old_table = table_;
+                auto old_capacity = capacity_;
+
+                capacity_ = (old_capacity != 0) ? old_capacity * 2
+                                                : std::size_t(INITIAL_CAPACITY);
+                table_ = reinterpret_cast<Slot*>(
+                        mp.allocate(sizeof(Slot), capacity_));
+
+                for (std::size_t i = 0; i < capacity_; ++i) {
+                    table_[i].node = nullptr;
+                }
+
+                for (std::size_t i = 0; i < old_capacity; ++i) {
+                    auto& old_slot = old_table[i];
+
+                    if (old_slot.node != nullptr) {
+                        free_slot(old_slot.hash) = old_slot;
+                    }
+                }
+
+                if (old_table != nullptr) {
+                    mp.deallocate(old_table, sizeof(Slot), old_capacity);
+                }
+            }
+
+            Slot* table_{nullptr};
+            std::size_t capacity_{0};
+            std::size_t size_{0};
+        };
+
         /**
          * @private
          */
@@ -278,6 +753,7 @@ namespace futoin {
         using StackDestroyHandler = void (*)(void*);
         using StepData = asyncsteps::StepData;
         using BaseState = asyncsteps::BaseState;
+        using ParallelMode = asyncsteps::ParallelMode;
 
         template<typename FP>
         using ExtendedExecPass = details::functor_pass::Simple<
@@ -364,6 +840,40 @@ namespace futoin {
          */
         virtual IAsyncSteps& parallel(ErrorPass on_error = {}) noexcept = 0;
 
+        /**
+         * @brief Get parallelized IAsyncSteps of specific mode
+         *
+         * Sub-steps of ParallelMode::Threads may run on other threads and
+         * get own state(). Results and errors are joined back to this
+         * instance.
+         *
+         * @note Implementations without thread support fall back to
+         *       pseudo-parallel mode.
+         */
+        IAsyncSteps& parallel(ErrorPass on_error, ParallelMode mode) noexcept
+        {
+            return parallel_impl(on_error, mode, 0);
+        }
+
+        /**
+         * @brief Get parallelized IAsyncSteps with concurrency limit
+         *
+         * At most limit sub-steps are active at a time, the next one
+         * starts as soon as any active completes. The first error cancels
+         * active sub-steps and drops not started ones like in parallel().
+         *
+         * @note Zero limit means no limit.
+         * @note Implementations without limit support start all sub-steps
+         *       at once.
+         */
+        IAsyncSteps& parallel(
+                ErrorPass on_error,
+                std::size_t limit,
+                ParallelMode mode = ParallelMode::Pseudo) noexcept
+        {
+            return parallel_impl(on_error, mode, limit);
+        }
+
         /**
          * @brief Reference to associated state object.
          */
@@ -393,6 +903,74 @@ namespace futoin {
             return any_cast<T&>(val);
         }
 
+        /**
+         * @brief Handy helper to access state variables by pre-hashed key
+         */
+        template<typename T>
+        T& state(const asyncsteps::HashedKey& key)
+        {
+            return any_cast<T&>(state()[key]);
+        }
+
+        /**
+         * @brief Handy helper to access state variables with default value
+         *        by pre-hashed key
+         */
+        template<typename T>
+        T& state(const asyncsteps::HashedKey& key, T&& def_val)
+        {
+            any& val = state()[key];
+
+            if (!val.has_value()) {
+                val = std::forward<T>(def_val);
+            }
+
+            return any_cast<T&>(val);
+        }
+
+        /**
+         * @brief Handy helper to access typed state slot
+         */
+        template<typename T>
+        T& state(const asyncsteps::StateKey<T>& key)
+        {
+            return state().slot(key);
+        }
+
+        /**
+         * @brief Handy helper to access typed state slot with default value
+         */
+        template<typename T, typename V>
+        T& state(const asyncsteps::StateKey<T>& key, V&& def_val)
+        {
+            return state().slot(key, std::forward<V>(def_val));
+        }
+
+        /**
+         * @brief Handy helper to access state variables by literal key
+         * @note Key hash calculation can be folded by the optimizer, but
+         *       it is not guaranteed. Use static constexpr HashedKey to get
+         *       it calculated at compile time.
+         */
+        template<typename T, std::size_t N>
+        // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+        T& state(const char (&key)[N])
+        {
+            return state<T>(asyncsteps::HashedKey(key));
+        }
+
+        /**
+         * @brief Handy helper to access state variables with default value
+         *        by literal key
+         */
+        template<typename T, std::size_t N>
+        // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+        T& state(const char (&key)[N], T&& def_val)
+        {
+            return state<T>(
+                    asyncsteps::HashedKey(key), std::forward<T>(def_val));
+        }
+
         /**
          * @brief Copy steps from a model step.
          */
@@ -496,6 +1074,7 @@ namespace futoin {
 
         /**
          * @brief Create memory allocation with lifetime of the step.
+         * @note ri::StepArena is a reference bump arena to back it.
          */
         virtual void* stack(
                 std::size_t object_size,
@@ -629,13 +1208,17 @@ namespace futoin {
         /**
          * @brief Interrupt execution burst
          *
-         * Relinquishes the current flow back to the event loop.
+         * Relinquishes the current flow back to the event loop. It is
+         * resumed in the priority lane of state().
          */
         void relinquish() noexcept
         {
             add([](IAsyncSteps& asi) {
-                auto bin_handle =
-                        asi.tool().immediate([&]() { asi.success(); }).binary();
+                auto bin_handle = asi.tool()
+                                          .immediate_priority(
+                                                  asi.state().priority(),
+                                                  [&]() { asi.success(); })
+                                          .binary();
                 asi.setCancel([bin_handle](IAsyncSteps&) {
                     IAsyncTool::Handle(bin_handle).cancel();
                 });
@@ -901,6 +1484,71 @@ namespace futoin {
             return forEach(std::move(c), ExtendedExecPass<FP>(func), label);
         }
 
+        /**
+         * @brief Process random access container in parallel chunks
+         *
+         * The range is split into chunks of chunk elements. Each chunk is
+         * a single parallel() sub-step which calls
+         * func(IAsyncSteps&, std::size_t i, V& val) for its elements in a
+         * row, so there is one step transition per chunk instead of one
+         * per element. Sub-steps added by func run after the chunk.
+         *
+         * @note Mind lifetime of the container!
+         * @note func is kept in stack() of this instance. In
+         *       ParallelMode::Threads, it is shared by the chunks instead
+         *       and may be called concurrently.
+         * @note Use error() to stop a chunk, errorNoThrow() does not stop
+         *       calls for the rest of its elements.
+         * @note Zero chunk is treated as one.
+         */
+        template<typename C, typename F>
+        IAsyncSteps& parallelForEach(
+                std::reference_wrapper<C> cr,
+                F&& func,
+                std::size_t concurrency = 0,
+                std::size_t chunk = 1,
+                ParallelMode mode = ParallelMode::Pseudo,
+                ErrorPass on_error = {}) noexcept
+        {
+            using Fn = typename std::decay<F>::type;
+            using Iter = decltype(std::begin(cr.get()));
+            using Diff = typename std::iterator_traits<Iter>::difference_type;
+            static_assert(
+                    std::is_base_of<
+                            std::random_access_iterator_tag,
+                            typename std::iterator_traits<
+                                    Iter>::iterator_category>::value,
+                    "Random access container is required");
+
+            using Chunks = ForEachChunks<C, Fn>;
+
+            auto& c = cr.get();
+            auto& p = parallel(on_error, concurrency, mode);
+            const auto size =
+                    static_cast<std::size_t>(std::end(c) - std::begin(c));
+
+            if (chunk == 0) {
+                chunk = 1;
+            }
+
+            if (mode == ParallelMode::Threads) {
+                // A started chunk may outlive this frame on cancel
+                add_chunks<Diff>(
+                        p,
+                        std::make_shared<Chunks>(c, std::forward<F>(func)),
+                        size,
+                        chunk);
+            } else {
+                add_chunks<Diff>(
+                        p,
+                        &stack<Chunks>(c, std::forward<F>(func)),
+                        size,
+                        chunk);
+            }
+
+            return *this;
+        }
+
         /**
          * @brief Break async loop.
          *
@@ -1069,7 +1717,49 @@ namespace futoin {
         virtual StepData& add_sync(ISync&) noexcept = 0;
         virtual void await_impl(AwaitPass) noexcept = 0;
 
+        virtual IAsyncSteps& parallel_impl(
+                ErrorPass on_error,
+                ParallelMode /*mode*/,
+                std::size_t /*limit*/) noexcept
+        {
+            return parallel(on_error);
+        }
+
     private:
+        template<typename C, typename Fn>
+        struct ForEachChunks
+        {
+            template<typename F>
+            ForEachChunks(C& c, F&& func) :
+                c(c), func(std::forward<F>(func))
+            {}
+
+            C& c;
+            Fn func;
+        };
+
+        template<typename Diff, typename Holder>
+        static void add_chunks(
+                IAsyncSteps& p,
+                const Holder& h,
+                std::size_t size,
+                std::size_t chunk) noexcept
+        {
+            for (std::size_t first = 0; first < size; first += chunk) {
+                const auto last =
+                        (size - first > chunk) ? (first + chunk) : size;
+
+                p.add([h, first, last](IAsyncSteps& as) {
+                    auto& chunks = *h;
+                    auto iter = std::begin(chunks.c) + static_cast<Diff>(first);
+
+                    for (auto i = first; i < last; ++i, ++iter) {
+                        chunks.func(as, i, *iter);
+                    }
+                });
+            }
+        }
+
         void promise_complete_step(std::promise<void>& promise)
         {
             add([&](IAsyncSteps&) { promise.set_value(); });
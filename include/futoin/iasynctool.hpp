@@ -25,7 +25,9 @@
 #include "details/reqcpp11.hpp"
 //---
 #include <chrono>
+#include <cstdint>
 #include <functional>
+#include <limits>
 //---
 #include "binarysteps.h"
 #include "details/functor_pass.hpp"
@@ -46,10 +48,34 @@ namespace futoin {
         using Callback = CallbackPass::Function;
         using HandleCookie = std::ptrdiff_t;
 
+        /**
+         * @brief Lane of immediate callbacks
+         * @note Higher lanes run first, but lower lanes are not starved.
+         */
+        enum class Priority : std::uint8_t
+        {
+            High,
+            Normal,
+            Low,
+        };
+        static constexpr std::size_t PRIORITY_COUNT = 3;
+
     protected:
         struct HandleAccessor;
         /**
          * @private
+         * @brief Tool side of Handle
+         *
+         * Handle validity is checked inline as generation == cookie with
+         * no call to the tool. Each implementation must follow it:
+         * - pass the current generation as cookie on Handle creation;
+         * - bump generation when the callback runs or gets canceled,
+         *   before the memory is reused for another callback;
+         * - keep the memory till the tool is destroyed.
+         *
+         * Handle::cancel() calls the tool only for valid handles. A tool
+         * which does not maintain generation gets handles which are either
+         * valid forever or never valid, so cancel() silently does nothing.
          */
         struct InternalHandle
         {
@@ -63,6 +89,7 @@ namespace futoin {
 
             Callback callback;
             CallbackPass::Storage storage;
+            HandleCookie generation{1};
         };
 
     public:
@@ -99,9 +126,8 @@ namespace futoin {
             }
             Handle& operator=(const FutoInHandle& other) noexcept
             {
-                internal_ = reinterpret_cast<decltype(internal_)>(other.data1);
-                async_tool_ =
-                        reinterpret_cast<decltype(async_tool_)>(other.data2);
+                internal_ = static_cast<InternalHandle*>(other.data1);
+                async_tool_ = static_cast<IAsyncTool*>(other.data2);
                 cookie_ = other.data3;
                 return *this;
             }
@@ -116,9 +142,12 @@ namespace futoin {
 
             ~Handle() noexcept = default;
 
+            /**
+             * @note Stale handles are skipped with no virtual call.
+             */
             void cancel() noexcept
             {
-                if (internal_ != nullptr) {
+                if (*this) {
                     async_tool_->cancel(*this);
                 }
             }
@@ -128,10 +157,14 @@ namespace futoin {
                 internal_ = nullptr;
             }
 
+            /**
+             * @brief Check if callback is still pending
+             * @note Inline generation check, no virtual call.
+             */
             operator bool() const noexcept
             {
                 return (internal_ != nullptr)
-                       && async_tool_->is_valid(*const_cast<Handle*>(this));
+                       && (internal_->generation == cookie_);
             }
 
         private:
@@ -148,6 +181,41 @@ namespace futoin {
          */
         virtual Handle immediate(CallbackPass&& cb) noexcept = 0;
 
+        /**
+         * @brief Schedule immediate callback in priority lane
+         * @note immediate() and immediate_batch() use Priority::Normal.
+         *       Default implementation ignores the priority.
+         */
+        virtual Handle immediate_priority(
+                Priority prio, CallbackPass&& cb) noexcept
+        {
+            (void) prio;
+            return immediate(std::move(cb));
+        }
+
+        /**
+         * @brief Schedule many immediate callbacks at once
+         * @param cbs array of callbacks to be moved from
+         * @param count number of callbacks
+         * @param handles optional array of count handles to fill
+         * @note Callbacks run in the array order in Priority::Normal lane.
+         *       Functors referenced by cbs must be alive till return.
+         *       Default implementation falls back to repeated immediate().
+         */
+        virtual void immediate_batch(
+                CallbackPass* cbs,
+                std::size_t count,
+                Handle* handles = nullptr) noexcept
+        {
+            for (std::size_t i = 0; i < count; ++i) {
+                auto h = immediate(std::move(cbs[i]));
+
+                if (handles != nullptr) {
+                    handles[i] = std::move(h);
+                }
+            }
+        }
+
         /**
          * @brief Schedule deferred callback
          */
@@ -180,6 +248,88 @@ namespace futoin {
          */
         virtual CycleResult iterate() noexcept = 0;
 
+        /**
+         * @brief Limits of a single cycle
+         */
+        struct CycleBudget
+        {
+            CycleBudget(
+                    std::size_t max_callbacks =
+                            std::numeric_limits<std::size_t>::max(),
+                    std::chrono::microseconds time_slice =
+                            std::chrono::microseconds(0)) noexcept :
+                max_callbacks(max_callbacks),
+                time_slice(time_slice)
+            {}
+
+            //! Maximum number of callbacks to run
+            std::size_t max_callbacks;
+            //! Time limit, zero for no limit
+            std::chrono::microseconds time_slice;
+        };
+
+        /**
+         * @brief Statistics of a single cycle
+         */
+        struct CycleStats
+        {
+            //! Callbacks run
+            std::size_t callbacks{0};
+            //! Timers expired into ready queue
+            std::size_t expired{0};
+            //! Ready callbacks left for the next cycle
+            std::size_t pending{0};
+            //! Time spent in the cycle
+            std::chrono::microseconds elapsed{0};
+            //! Cycle stopped due to budget
+            bool exhausted{false};
+        };
+
+        /**
+         * @brief Iterate a cycle of internal loop within budget.
+         * @note For interleaving with external event loop. Default
+         *       implementation ignores the budget and fills only elapsed.
+         */
+        virtual CycleResult iterate(
+                const CycleBudget& budget,
+                CycleStats* stats = nullptr) noexcept
+        {
+            (void) budget;
+
+            auto started = std::chrono::steady_clock::now();
+            auto res = iterate();
+
+            if (stats != nullptr) {
+                *stats = CycleStats();
+                stats->elapsed =
+                        std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - started);
+            }
+
+            return res;
+        }
+
+        /**
+         * @brief File descriptor to watch for readability in external loop
+         * @return -1, if not supported
+         * @note It gets readable on cross-thread post or I/O completion
+         *       after iterate() has returned. Next iterate() clears it.
+         */
+        virtual int wakeup_fd() noexcept
+        {
+            return -1;
+        }
+
+        /**
+         * @brief Time of the next timer or now, if there is ready work
+         * @note time_point::max() means no timers. Default implementation
+         *       does not know, so it returns now.
+         */
+        virtual std::chrono::steady_clock::time_point next_deadline() noexcept
+        {
+            return std::chrono::steady_clock::now();
+        }
+
         /**
          * @brief IMemPool interface
          */
@@ -219,7 +369,14 @@ namespace futoin {
         };
 
         virtual void cancel(Handle& h) noexcept = 0;
-        virtual bool is_valid(Handle& h) noexcept = 0;
+
+        /**
+         * @note Not used by Handle, see InternalHandle for the contract.
+         */
+        virtual bool is_valid(Handle& h) noexcept
+        {
+            return static_cast<bool>(h);
+        }
     };
 } // namespace futoin
 
@@ -0,0 +1,308 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+//! @file
+//! @brief Reference IAsyncSteps execution engine
+//-----------------------------------------------------------------------------
+
+#ifndef FUTOIN_RI_ASYNCSTEPS_HPP
+#define FUTOIN_RI_ASYNCSTEPS_HPP
+//---
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+//---
+#include "../iasyncsteps.hpp"
+#include "../iasynctool.hpp"
+#include "../imempool.hpp"
+
+namespace futoin {
+    namespace ri {
+        class ReactorPool;
+
+        /**
+         * @brief Reference root IAsyncSteps implementation
+         *
+         * Each running step gets an execution frame, which is the
+         * IAsyncSteps instance passed to step functions. Sub-steps are
+         * queued in the frame and run one by one, parallel() branches run
+         * as sibling frames.
+         *
+         * Queued steps with their StepData, frames with their StepArena
+         * for stack() and LoopState objects are recycled through
+         * intrusive free lists of the root. Once warmed up, execution does
+         * no heap allocations per step. Objects of the root stack() live
+         * till completion, unhandled error handler or cancel() of the
+         * execution.
+         *
+         * Handler of setCancel() is called whenever its step is torn
+         * down without success: on cancel(), timeout or error.
+         *
+         * Every transition to the next step is scheduled with
+         * IAsyncTool::immediate_priority() in the lane of state(), unless
+         * inline continuation is enabled by set_inline_depth().
+         *
+         * parallel() with concurrency limit keeps not started branches
+         * queued in its frame and launches the next one as any active
+         * branch completes.
+         *
+         * ParallelMode::Threads branches are submitted to ReactorPool set
+         * by set_thread_pool() as separate roots and joined back through
+         * off-thread immediate() of the tool. Loop, sync and nested
+         * parallel branches still run in pseudo-parallel mode. A started
+         * thread branch is not interrupted by cancel, its result is
+         * discarded instead. Destructor does not wait for such branches,
+         * they release their resources on finish. So, a branch must not
+         * refer to objects destroyed with the root. A branch whose job or
+         * root is dropped by the pool, e.g. on stop(), fails with
+         * InternalError.
+         *
+         * @note All calls must be done from the thread of the tool.
+         *       copyFrom(), binary() and wrap() are not supported.
+         */
+        class AsyncSteps : public IAsyncSteps
+        {
+        public:
+            explicit AsyncSteps(IAsyncTool& tool) noexcept;
+            ~AsyncSteps() noexcept override;
+
+            AsyncSteps(const AsyncSteps&) = delete;
+            AsyncSteps& operator=(const AsyncSteps&) = delete;
+            AsyncSteps(AsyncSteps&&) = delete;
+            AsyncSteps& operator=(AsyncSteps&&) = delete;
+
+            using IAsyncSteps::parallel;
+            using IAsyncSteps::stack;
+            using IAsyncSteps::state;
+
+            IAsyncSteps& parallel(ErrorPass on_error = {}) noexcept override;
+            BaseState& state() noexcept override;
+
+            /**
+             * @brief Not supported, fatal error
+             * @note Queued step functors are move-only.
+             */
+            IAsyncSteps& copyFrom(IAsyncSteps& other) noexcept override;
+
+            SyncRootID sync_root_id() const override;
+            std::unique_ptr<IAsyncSteps> newInstance() noexcept override;
+            void* stack(
+                    std::size_t object_size,
+                    StackDestroyHandler destroy_cb =
+                            &asyncsteps::default_destroy_cb) noexcept override;
+
+            /**
+             * @brief Not supported, fatal error
+             */
+            FutoInAsyncSteps& binary() noexcept override;
+
+            /**
+             * @brief Not supported, fatal error
+             */
+            std::unique_ptr<IAsyncSteps> wrap(
+                    FutoInAsyncSteps& binary_steps) noexcept override;
+
+            IAsyncTool& tool() noexcept override;
+
+            void setTimeout(std::chrono::milliseconds to) noexcept override;
+            void setCancel(CancelPass cb) noexcept override;
+            void waitExternal() noexcept override;
+            operator bool() const noexcept override;
+
+            /**
+             * @brief Start execution of queued steps
+             * @note Root can be reused by adding new steps once it's
+             *       completed, canceled or failed.
+             */
+            void execute() noexcept override;
+            void cancel() noexcept override;
+
+            /**
+             * @brief Check if execution is in progress
+             */
+            inline bool is_running() const noexcept
+            {
+                return running_;
+            }
+
+            /**
+             * @brief Free recycled steps and frames
+             */
+            void release_memory() noexcept;
+
+            /**
+             * @brief Set limit of inline continuation
+             *
+             * A step which completes before return from its function is
+             * followed by the next step directly on the same call stack,
+             * up to depth nested transitions. At the limit, the transition
+             * goes through immediate_priority() to let other callbacks of
+             * the tool run. relinquish() and execute() always go through
+             * the tool, as well as success() or error() called outside of
+             * the step function, e.g. after waitExternal(). parallel()
+             * branches are always started through the tool, so each branch
+             * gets its turn.
+             *
+             * It saves a tool round trip per transition. Whether it pays
+             * off depends on the cost of the tool cycle compared to the
+             * step functions, so it should be measured with the actual
+             * tool and workload.
+             *
+             * @note Zero disables inline continuation, which is the
+             *       default. The depth is inherited by newInstance().
+             */
+            inline void set_inline_depth(std::size_t depth) noexcept
+            {
+                inline_depth_ = depth;
+            }
+
+            /**
+             * @brief Current limit of inline continuation
+             */
+            inline std::size_t inline_depth() const noexcept
+            {
+                return inline_depth_;
+            }
+
+            /**
+             * @brief Set pool for ParallelMode::Threads branches
+             * @note The pool must have StepsFactory. Its tools must accept
+             *       immediate() from foreign threads. Null disables thread
+             *       mode. The pool is inherited by newInstance().
+             */
+            inline void set_thread_pool(ReactorPool* pool) noexcept
+            {
+                thread_pool_ = pool;
+            }
+
+            /**
+             * @brief Current pool for ParallelMode::Threads branches
+             */
+            inline ReactorPool* thread_pool() const noexcept
+            {
+                return thread_pool_;
+            }
+
+        protected:
+            StepData& add_step() noexcept override;
+            void handle_success() noexcept override;
+            void handle_error(ErrorCode code) noexcept override;
+            asyncsteps::NextArgs& nextargs() noexcept override;
+            asyncsteps::LoopState& add_loop(
+                    asyncsteps::LoopLabel label) noexcept override;
+            StepData& add_sync(ISync& obj) noexcept override;
+            void await_impl(AwaitPass cb) noexcept override;
+            IAsyncSteps& parallel_impl(
+                    ErrorPass on_error,
+                    ParallelMode mode,
+                    std::size_t limit) noexcept override;
+
+        private:
+            class Frame;
+            struct Step;
+            struct LoopNode;
+            struct Guard;
+            struct Branch;
+            struct Hub;
+
+            /**
+             * @private
+             */
+            enum class Kind : std::uint8_t
+            {
+                Root,
+                Step,
+                Loop,
+                Parallel,
+                Iteration,
+                Lock,
+                Thread,
+            };
+
+            Step* alloc_step() noexcept;
+            void free_step(Step* s) noexcept;
+            Frame* alloc_frame() noexcept;
+            void free_frame(Frame* f) noexcept;
+            LoopNode* alloc_loop() noexcept;
+            void free_loop(LoopNode* n) noexcept;
+
+            Step& push_step(Frame& f) noexcept;
+            IAsyncSteps& push_parallel(
+                    Frame& f,
+                    ErrorPass& on_error,
+                    ParallelMode mode = ParallelMode::Pseudo,
+                    std::size_t limit = 0) noexcept;
+            asyncsteps::LoopState& push_loop(
+                    Frame& f, asyncsteps::LoopLabel label) noexcept;
+            StepData& push_sync(Frame& f, ISync& obj) noexcept;
+            void push_await(Frame& f, AwaitPass& cb) noexcept;
+            void set_timeout(Frame& f, std::chrono::milliseconds to) noexcept;
+            void set_cancel(Frame& f, CancelPass& cb) noexcept;
+            void on_success(Frame& f) noexcept;
+            void on_error(Frame& f, ErrorCode code) noexcept;
+
+            Frame* add_child(Frame* parent, Step* s, Kind kind) noexcept;
+            Step* pop_step(Frame* f) noexcept;
+            void launch(Frame* f) noexcept;
+            void schedule(Frame* f) noexcept;
+            void post(Frame* f) noexcept;
+            void proceed(Frame* f) noexcept;
+            void start(Frame* f) noexcept;
+            void resume(Frame* f) noexcept;
+            void loop_next(Frame* f) noexcept;
+            void run(Frame* f) noexcept;
+            template<typename Fn>
+            void invoke(Frame& f, const Fn& fn) noexcept;
+            void after_call(Frame* f) noexcept;
+            void complete(Frame* f) noexcept;
+            void fail(Frame* f, ErrorCode code) noexcept;
+            bool loop_control(Frame* f, ErrorCode code) noexcept;
+            void abort(Frame* f) noexcept;
+            void cancel_external(Frame* f) noexcept;
+            void abort_children(Frame* f) noexcept;
+            void drop_queue(Frame* f) noexcept;
+            void release(Frame* f) noexcept;
+            void finish() noexcept;
+            void do_cancel() noexcept;
+            void spawn(Frame* f) noexcept;
+            void join(Branch* b) noexcept;
+            void detach(Frame* f) noexcept;
+            void orphan_branches() noexcept;
+
+            IAsyncTool& tool_;
+            IMemPool& mem_pool_;
+            asyncsteps::HashedState state_;
+            asyncsteps::NextArgs next_args_;
+            Frame* root_{nullptr};
+            Step* free_steps_{nullptr};
+            Frame* free_frames_{nullptr};
+            LoopNode* free_loops_{nullptr};
+            std::size_t depth_{0};
+            bool cancel_pending_{false};
+            bool running_{false};
+            futoin::string exc_code_;
+            ReactorPool* thread_pool_{nullptr};
+            std::size_t inline_depth_{0};
+            std::size_t inline_level_{0};
+            std::shared_ptr<Hub> hub_;
+            Branch* detached_{nullptr};
+        };
+    } // namespace ri
+} // namespace futoin
+
+//---
+#endif // FUTOIN_RI_ASYNCSTEPS_HPP
@@ -0,0 +1,334 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+//! @file
+//! @brief Reference single-threaded IAsyncTool reactor
+//-----------------------------------------------------------------------------
+
+#ifndef FUTOIN_RI_REACTOR_HPP
+#define FUTOIN_RI_REACTOR_HPP
+//---
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+//---
+#include "../iasynctool.hpp"
+#include "../imempool.hpp"
+
+namespace futoin {
+    namespace ri {
+        /**
+         * @brief Single-threaded reference IAsyncTool implementation
+         *
+         * Immediate callbacks are kept in intrusive FIFO lanes, one per
+         * Priority. Higher lanes run first, but a pending lower lane is
+         * served after lane_burst() callbacks of higher lanes. Deferred
+         * callbacks are kept in a hierarchical timing wheel of
+         * WHEEL_LEVELS x WHEEL_SIZE buckets with 1 ms ticks, so insert
+         * and cancel are O(1). Expired timers are appended to the normal
+         * lane. Timers beyond the wheel span of about 49.7 days are placed
+         * again on each cascade till the deadline, so they never fire
+         * early.
+         *
+         * InternalHandle slots are drawn from a pool allocated in chunks
+         * from IMemPool. Slot generation is used as HandleCookie, so stale
+         * handles are detected after slot reuse.
+         *
+         * immediate(), immediate_priority(), immediate_batch() and
+         * deferred() called from a foreign thread go to a wait-free MPSC
+         * inbox drained at the start of iterate(). The
+         * owner thread path takes no locks. run() sleeps on eventfd on
+         * Linux and a condition variable elsewhere, so posts wake it up.
+         * The same eventfd is wakeup_fd() for external event loops.
+         *
+         * @note Except for the scheduling calls above and wakeup(), all
+         *       calls must be done from the owner thread. Off-thread calls return
+         *       an empty Handle.
+         */
+        class Reactor : public IAsyncTool
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+            using Tick = std::uint64_t;
+
+            static constexpr unsigned WHEEL_BITS = 8;
+            static constexpr std::size_t WHEEL_SIZE = 1U << WHEEL_BITS;
+            static constexpr std::size_t WHEEL_LEVELS = 4;
+            static constexpr std::size_t SLOT_CHUNK = 64;
+            static constexpr std::size_t DEFAULT_LANE_BURST = 16;
+
+            explicit Reactor(
+                    IMemPool& mem_pool = GlobalMemPool::get_default()) noexcept;
+            ~Reactor() noexcept override;
+
+            Handle immediate(CallbackPass&& cb) noexcept override;
+            Handle immediate_priority(
+                    Priority prio, CallbackPass&& cb) noexcept override;
+            Handle deferred(
+                    std::chrono::milliseconds delay,
+                    CallbackPass&& cb) noexcept override;
+            void immediate_batch(
+                    CallbackPass* cbs,
+                    std::size_t count,
+                    Handle* handles = nullptr) noexcept override;
+            bool is_same_thread() noexcept override;
+            CycleResult iterate() noexcept override;
+            CycleResult iterate(
+                    const CycleBudget& budget,
+                    CycleStats* stats = nullptr) noexcept override;
+
+            int wakeup_fd() noexcept override;
+            Clock::time_point next_deadline() noexcept override;
+
+            IMemPool& mem_pool(
+                    std::size_t object_size = 1,
+                    bool optimize = false) noexcept override;
+            void release_memory() noexcept override;
+
+            /**
+             * @brief Set timer coalescing slack
+             *
+             * Deadlines of deferred() calls with delay not less than slack
+             * are rounded up to a multiple of slack. Timers within the same
+             * slack window share a wheel bucket and a wakeup.
+             *
+             * @note Zero disables coalescing, which is the default.
+             */
+            void set_timer_slack(std::chrono::milliseconds slack) noexcept;
+
+            /**
+             * @brief Current timer coalescing slack
+             */
+            inline std::chrono::milliseconds timer_slack() const noexcept
+            {
+                return std::chrono::milliseconds(timer_slack_);
+            }
+
+            /**
+             * @brief Set starvation limit of priority lanes
+             *
+             * A pending lower lane gets one callback after at most burst
+             * callbacks of higher lanes in a row.
+             *
+             * @note Zero is treated as one.
+             */
+            void set_lane_burst(std::size_t burst) noexcept;
+
+            /**
+             * @brief Current starvation limit of priority lanes
+             */
+            inline std::size_t lane_burst() const noexcept
+            {
+                return lane_burst_;
+            }
+
+            /**
+             * @brief Make the calling thread owner of the reactor
+             */
+            void bind_thread() noexcept;
+
+            /**
+             * @brief Iterate and sleep till there is no more work
+             */
+            void run() noexcept;
+
+            /**
+             * @brief Sleep till timeout, wakeup() or off-thread post
+             * @note Negative timeout means no limit.
+             */
+            void wait(std::chrono::milliseconds timeout) noexcept;
+
+            /**
+             * @brief Interrupt current or next wait() from any thread
+             */
+            void wakeup() noexcept;
+
+            /**
+             * @brief Number of pending immediate callbacks
+             */
+            inline std::size_t immediate_count() const noexcept
+            {
+                std::size_t res = 0;
+
+                for (auto& l : lanes_) {
+                    res += l.size;
+                }
+
+                return res;
+            }
+
+            /**
+             * @brief Number of pending immediate callbacks in a lane
+             */
+            inline std::size_t immediate_count(Priority prio) const noexcept
+            {
+                return lanes_[static_cast<std::size_t>(prio)].size;
+            }
+
+            /**
+             * @brief Number of pending deferred callbacks
+             */
+            inline std::size_t deferred_count() const noexcept
+            {
+                return timer_count_;
+            }
+
+        protected:
+            void cancel(Handle& h) noexcept override;
+
+            /**
+             * @brief Block till timeout or wakeup()
+             * @note Called by wait() after checking the inbox. Negative
+             *       timeout means no limit.
+             */
+            virtual void sleep(std::chrono::milliseconds timeout) noexcept;
+
+            /**
+             * @brief Consume pending wakeup() signal
+             */
+            virtual void drain_wakeup() noexcept;
+
+            /**
+             * @brief eventfd signalled by wakeup(), -1 if not available
+             */
+            inline int event_fd() const noexcept
+            {
+                return event_fd_;
+            }
+
+            /**
+             * @brief Time source
+             * @note It may be overridden, e.g. to simulate time in tests.
+             */
+            virtual Clock::time_point now() const noexcept
+            {
+                return Clock::now();
+            }
+
+        private:
+            struct Slot;
+            struct SlotChunk;
+            struct InboxNode;
+            struct InboxCall;
+
+            /**
+             * @private
+             */
+            struct InboxLink
+            {
+                std::atomic<InboxLink*> next{nullptr};
+            };
+
+            /**
+             * @private
+             */
+            struct SlotList
+            {
+                Slot* head{nullptr};
+                Slot* tail{nullptr};
+                std::size_t size{0};
+
+                void push_back(Slot* s) noexcept;
+                void remove(Slot* s) noexcept;
+                Slot* pop_front() noexcept;
+            };
+
+            /**
+             * @private
+             */
+            struct Level
+            {
+                std::array<SlotList, WHEEL_SIZE> buckets;
+                std::array<std::uint64_t, WHEEL_SIZE / 64> used{};
+            };
+
+            using LaneQuota = std::array<std::size_t, PRIORITY_COUNT>;
+
+            inline SlotList& lane(Priority prio) noexcept
+            {
+                return lanes_[static_cast<std::size_t>(prio)];
+            }
+
+            bool is_lane(const SlotList* l) const noexcept;
+            Slot* pop_ready() noexcept;
+
+            void reserve_slots(std::size_t count) noexcept;
+            Slot* alloc_slot(CallbackPass& cb) noexcept;
+            void free_slot(Slot* s) noexcept;
+            Handle make_handle(Slot* s) noexcept;
+            Slot* handle_slot(Handle& h) noexcept;
+
+            Handle post(
+                    CallbackPass& cb,
+                    std::chrono::milliseconds delay,
+                    bool deferred,
+                    Priority prio = Priority::Normal) noexcept;
+            void inbox_push(InboxLink* n) noexcept;
+            InboxNode* inbox_pop() noexcept;
+            bool inbox_empty() const noexcept;
+            bool arm_waiting() noexcept;
+            void drain_inbox() noexcept;
+            void free_node(InboxNode* n) noexcept;
+
+            Tick now_tick() const noexcept;
+            Tick expire_tick(
+                    Clock::time_point when,
+                    std::chrono::milliseconds delay) const noexcept;
+            void insert_timer(Slot* s) noexcept;
+            void place_timer(Slot* s) noexcept;
+            void remove_timer(Slot* s) noexcept;
+            void advance(Tick now) noexcept;
+            void cascade(std::size_t level) noexcept;
+            void expire_bucket() noexcept;
+            Tick next_wakeup() const noexcept;
+
+            IMemPool& mem_pool_;
+            std::thread::id owner_;
+            const Clock::time_point start_;
+            Tick current_tick_{0};
+            Tick timer_slack_{0};
+            std::size_t timer_count_{0};
+            std::array<SlotList, PRIORITY_COUNT> lanes_;
+            LaneQuota lane_skips_{};
+            // Live snapshot callbacks of the running cycle
+            LaneQuota quota_{};
+            std::size_t cycle_{0};
+            std::size_t lane_burst_{DEFAULT_LANE_BURST};
+            std::array<Level, WHEEL_LEVELS> wheel_;
+            Slot* free_slots_{nullptr};
+            SlotChunk* chunks_{nullptr};
+            std::size_t free_count_{0};
+
+            InboxLink inbox_stub_;
+            std::atomic<InboxLink*> inbox_head_{&inbox_stub_};
+            InboxLink* inbox_tail_{&inbox_stub_};
+            std::atomic<bool> waiting_{false};
+            std::atomic<bool> signalled_{false};
+
+            int event_fd_{-1};
+            std::mutex wake_mutex_;
+            std::condition_variable wake_cv_;
+            bool woken_{false};
+        };
+    } // namespace ri
+} // namespace futoin
+
+//---
+#endif // FUTOIN_RI_REACTOR_HPP
@@ -0,0 +1,159 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+//! @file
+//! @brief Reference work-stealing pool of reactors
+//-----------------------------------------------------------------------------
+
+#ifndef FUTOIN_RI_REACTORPOOL_HPP
+#define FUTOIN_RI_REACTORPOOL_HPP
+//---
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+//---
+#include "../iasyncsteps.hpp"
+#include "../iasynctool.hpp"
+
+namespace futoin {
+    namespace ri {
+        class Reactor;
+
+        /**
+         * @brief Pool of single-threaded reactors with work stealing
+         *
+         * Each worker thread owns a ri::Reactor and a deque of root jobs.
+         * A worker starts one own job per reactor cycle from the front of
+         * its deque. An idle worker steals from the back of other deques.
+         * Idle workers sleep in Reactor::wait(), so off-thread posts to
+         * their reactors wake them up as well.
+         *
+         * Only jobs which have not started yet are stolen. Once started,
+         * a job and all IAsyncSteps it creates stay bound to the reactor
+         * of that worker, so IAsyncTool::is_same_thread() and ISync
+         * semantics are not affected.
+         *
+         * @note submit() is safe to call from any thread.
+         */
+        class ReactorPool
+        {
+        public:
+            using Job = std::function<void(IAsyncTool&)>;
+            using StepsSetup = std::function<void(IAsyncSteps&)>;
+            using StepsFactory =
+                    std::function<std::unique_ptr<IAsyncSteps>(IAsyncTool&)>;
+
+            /**
+             * @param threads number of workers, zero for hardware concurrency
+             * @param steps_factory creates a root IAsyncSteps prototype
+             *        per worker for submit_steps()
+             */
+            explicit ReactorPool(
+                    std::size_t threads = 0,
+                    StepsFactory steps_factory = {}) noexcept;
+            ~ReactorPool() noexcept;
+
+            ReactorPool(const ReactorPool&) = delete;
+            ReactorPool& operator=(const ReactorPool&) = delete;
+            ReactorPool(ReactorPool&&) = delete;
+            ReactorPool& operator=(ReactorPool&&) = delete;
+
+            /**
+             * @brief Queue a root job
+             * @note Pool thread queues to own deque, others go round-robin.
+             */
+            void submit(Job&& job) noexcept;
+
+            /**
+             * @brief Queue a root job to specific worker deque
+             * @note It may still be stolen before start.
+             */
+            void submit_to(std::size_t worker, Job&& job) noexcept;
+
+            /**
+             * @brief Queue a root IAsyncSteps to be set up and executed
+             * @note Instance is created by newInstance() of worker prototype
+             *       and released when its execution ends with success,
+             *       error or cancel.
+             * @note Unhandled errors are ignored, unless setup installs
+             *       own handler.
+             * @note It is a fatal error to call it on a pool constructed
+             *       without StepsFactory.
+             */
+            void submit_steps(StepsSetup&& setup) noexcept;
+
+            /**
+             * @brief Stop workers and wait for them
+             * @note Running job calls are completed. Not started jobs
+             *       and unfinished roots of submit_steps() are destroyed.
+             *       No job runs after return, jobs submitted later are
+             *       destroyed right away. It can be called repeatedly,
+             *       but not from a pool thread.
+             */
+            void stop() noexcept;
+
+            /**
+             * @brief Number of workers
+             */
+            inline std::size_t size() const noexcept
+            {
+                return workers_.size();
+            }
+
+            /**
+             * @brief Total number of stolen jobs
+             */
+            inline std::size_t steal_count() const noexcept
+            {
+                return steals_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            struct Worker;
+
+            struct StepsJob;
+            struct RootRelease;
+
+            void run(Worker& w) noexcept;
+            void wake_idle(std::size_t skip) noexcept;
+            void start_steps(StepsSetup& setup) noexcept;
+            bool pop_local(Worker& w, Job& job) noexcept;
+            bool steal(Worker& w, Job& job) noexcept;
+
+            std::vector<std::unique_ptr<Worker>> workers_;
+            StepsFactory steps_factory_;
+            std::atomic<std::size_t> next_worker_{0};
+            std::atomic<std::size_t> pending_{0};
+            std::atomic<std::size_t> steals_{0};
+            std::atomic<bool> stop_{false};
+
+            std::mutex ready_mutex_;
+            std::condition_variable ready_cv_;
+            std::size_t ready_{0};
+
+            static thread_local Worker* current_worker_;
+        };
+    } // namespace ri
+} // namespace futoin
+
+//---
+#endif // FUTOIN_RI_REACTORPOOL_HPP
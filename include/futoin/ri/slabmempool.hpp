@@ -0,0 +1,364 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+//! @file
+//! @brief Reference size-class slab memory pool
+//-----------------------------------------------------------------------------
+
+#ifndef FUTOIN_RI_SLABMEMPOOL_HPP
+#define FUTOIN_RI_SLABMEMPOOL_HPP
+//---
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+//---
+#include "../imempool.hpp"
+
+namespace futoin {
+    namespace ri {
+        /**
+         * @brief Thread-confined slab memory pool with size classes
+         *
+         * Requests of up to MAX_OBJECT_SIZE bytes are served from one
+         * free list per size class. Free lists are carved out of chunks
+         * lazily. Larger requests pass through to the default heap.
+         *
+         * mem_pool() with optimize flag returns dedicated per size class
+         * pool to skip size class lookup on each call.
+         *
+         * deallocate() from a foreign thread pushes the block into
+         * a lock-free MPSC remote free queue. The owner thread drains it
+         * on release_memory() or once a local free list runs empty.
+         *
+         * @note Allocation must be done only by the owner thread, e.g.
+         *       the one which called GlobalMemPool::set_thread_default().
+         * @note The instance must outlive all blocks it has returned.
+         */
+        class SlabMemPool : public IMemPool
+        {
+        public:
+            static constexpr std::size_t GRANULARITY =
+                    alignof(std::max_align_t);
+            static constexpr std::size_t MAX_OBJECT_SIZE = 1024;
+            static constexpr std::size_t CLASS_COUNT =
+                    MAX_OBJECT_SIZE / GRANULARITY;
+            static constexpr std::size_t MIN_CHUNK_SIZE = 16 * 1024;
+            static constexpr std::size_t MIN_CHUNK_OBJECTS = 32;
+
+            SlabMemPool() noexcept : owner_(std::this_thread::get_id())
+            {
+                static_assert(
+                        sizeof(RemoteNode) <= GRANULARITY,
+                        "Remote free node does not fit the smallest class");
+
+                for (std::size_t i = 0; i < CLASS_COUNT; ++i) {
+                    classes_[i].init(*this, (i + 1) * GRANULARITY);
+                }
+            }
+
+            ~SlabMemPool() noexcept override
+            {
+                for (auto& c : classes_) {
+                    c.free_chunks();
+                }
+            }
+
+            /**
+             * @brief Make the calling thread owner of the pool
+             * @note To be used before the first allocation, if the pool
+             *       is created by other thread than its user.
+             */
+            void bind_thread() noexcept
+            {
+                owner_ = std::this_thread::get_id();
+            }
+
+            inline bool is_owner_thread() const noexcept
+            {
+                return owner_ == std::this_thread::get_id();
+            }
+
+            void* allocate(
+                    std::size_t object_size,
+                    std::size_t count) noexcept override
+            {
+                auto size = object_size * count;
+
+                if (size > MAX_OBJECT_SIZE) {
+                    return ::new char[size];
+                }
+
+                return classes_[class_index(size)].pop();
+            }
+
+            void deallocate(
+                    void* ptr,
+                    std::size_t object_size,
+                    std::size_t count) noexcept override
+            {
+                auto size = object_size * count;
+
+                if (size > MAX_OBJECT_SIZE) {
+                    ::delete[] reinterpret_cast<char*>(ptr);
+                    return;
+                }
+
+                auto index = class_index(size);
+
+                if (is_owner_thread()) {
+                    classes_[index].push(ptr);
+                } else {
+                    remote_push(ptr, index);
+                }
+            }
+
+            /**
+             * @brief Free chunks of size classes with no live objects
+             * @note Must be called from the owner thread.
+             */
+            void release_memory() noexcept override
+            {
+                drain_remote();
+
+                for (auto& c : classes_) {
+                    c.release_unused();
+                }
+            }
+
+            IMemPool& mem_pool(
+                    std::size_t object_size = 1,
+                    bool optimize = false) noexcept override
+            {
+                if (optimize && (object_size <= MAX_OBJECT_SIZE)) {
+                    return classes_[class_index(object_size)];
+                }
+
+                return *this;
+            }
+
+            static constexpr std::size_t class_index(std::size_t size) noexcept
+            {
+                return (size != 0) ? (size - 1) / GRANULARITY : 0;
+            }
+
+        private:
+            /**
+             * @private
+             */
+            struct FreeNode
+            {
+                FreeNode* next;
+            };
+
+            /**
+             * @private
+             */
+            struct Chunk
+            {
+                Chunk* next;
+            };
+
+            /**
+             * @private
+             */
+            struct RemoteNode
+            {
+                RemoteNode* next;
+                std::size_t class_index;
+            };
+
+            static constexpr std::size_t CHUNK_HEADER_SIZE =
+                    ((sizeof(Chunk) + GRANULARITY - 1) / GRANULARITY)
+                    * GRANULARITY;
+
+            /**
+             * @private
+             */
+            class SizeClass final : public IMemPool
+            {
+            public:
+                void init(SlabMemPool& parent, std::size_t object_size) noexcept
+                {
+                    parent_ = &parent;
+                    object_size_ = object_size;
+
+                    chunk_size_ =
+                            CHUNK_HEADER_SIZE + object_size * MIN_CHUNK_OBJECTS;
+
+                    if (chunk_size_ < MIN_CHUNK_SIZE) {
+                        chunk_size_ = MIN_CHUNK_SIZE;
+                    }
+                }
+
+                void* allocate(
+                        std::size_t object_size,
+                        std::size_t count) noexcept override
+                {
+                    if (is_own(object_size * count)) {
+                        return pop();
+                    }
+
+                    return parent_->allocate(object_size, count);
+                }
+
+                void deallocate(
+                        void* ptr,
+                        std::size_t object_size,
+                        std::size_t count) noexcept override
+                {
+                    if (is_own(object_size * count)
+                        && parent_->is_owner_thread()) {
+                        push(ptr);
+                    } else {
+                        parent_->deallocate(ptr, object_size, count);
+                    }
+                }
+
+                void release_memory() noexcept override
+                {
+                    parent_->drain_remote();
+                    release_unused();
+                }
+
+                void release_unused() noexcept
+                {
+                    if (live_ == 0) {
+                        free_chunks();
+                    }
+                }
+
+                IMemPool& mem_pool(
+                        std::size_t object_size = 1,
+                        bool optimize = false) noexcept override
+                {
+                    return parent_->mem_pool(object_size, optimize);
+                }
+
+                inline void* pop() noexcept
+                {
+                    void* res;
+
+                    if ((free_ == nullptr) && (bump_ == bump_end_)) {
+                        parent_->drain_remote();
+                    }
+
+                    if (free_ != nullptr) {
+                        res = free_;
+                        free_ = free_->next;
+                    } else {
+                        if (bump_ == bump_end_) {
+                            add_chunk();
+                        }
+
+                        res = bump_;
+                        bump_ += object_size_;
+                    }
+
+                    ++live_;
+                    return res;
+                }
+
+                inline void push(void* ptr) noexcept
+                {
+                    auto* node = reinterpret_cast<FreeNode*>(ptr);
+                    node->next = free_;
+                    free_ = node;
+                    --live_;
+                }
+
+                void free_chunks() noexcept
+                {
+                    while (chunks_ != nullptr) {
+                        auto* c = chunks_;
+                        chunks_ = c->next;
+                        ::delete[] reinterpret_cast<char*>(c);
+                    }
+
+                    free_ = nullptr;
+                    bump_ = nullptr;
+                    bump_end_ = nullptr;
+                }
+
+            private:
+                inline bool is_own(std::size_t size) const noexcept
+                {
+                    return (size <= object_size_)
+                           && (size + GRANULARITY > object_size_);
+                }
+
+                void add_chunk() noexcept
+                {
+                    auto* raw = ::new char[chunk_size_];
+                    auto* c = reinterpret_cast<Chunk*>(raw);
+                    c->next = chunks_;
+                    chunks_ = c;
+
+                    auto usable = chunk_size_ - CHUNK_HEADER_SIZE;
+                    bump_ = raw + CHUNK_HEADER_SIZE;
+                    bump_end_ = bump_ + (usable - (usable % object_size_));
+                }
+
+                SlabMemPool* parent_{nullptr};
+                std::size_t object_size_{0};
+                std::size_t chunk_size_{0};
+                std::size_t live_{0};
+                FreeNode* free_{nullptr};
+                char* bump_{nullptr};
+                char* bump_end_{nullptr};
+                Chunk* chunks_{nullptr};
+            };
+
+            void remote_push(void* ptr, std::size_t index) noexcept
+            {
+                auto* node = reinterpret_cast<RemoteNode*>(ptr);
+                node->class_index = index;
+                node->next = remote_head_.load(std::memory_order_relaxed);
+
+                while (!remote_head_.compare_exchange_weak(
+                        node->next,
+                        node,
+                        std::memory_order_release,
+                        std::memory_order_relaxed)) {
+                }
+            }
+
+            void drain_remote() noexcept
+            {
+                if (remote_head_.load(std::memory_order_relaxed) == nullptr) {
+                    return;
+                }
+
+                auto* node = remote_head_.exchange(
+                        nullptr, std::memory_order_acquire);
+
+                while (node != nullptr) {
+                    auto* next = node->next;
+                    classes_[node->class_index].push(node);
+                    node = next;
+                }
+            }
+
+            std::array<SizeClass, CLASS_COUNT> classes_;
+            std::thread::id owner_;
+            std::atomic<RemoteNode*> remote_head_{nullptr};
+        };
+    } // namespace ri
+} // namespace futoin
+
+//---
+#endif // FUTOIN_RI_SLABMEMPOOL_HPP
@@ -0,0 +1,228 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+//! @file
+//! @brief Reference bump arena for IAsyncSteps::stack() allocations
+//-----------------------------------------------------------------------------
+
+#ifndef FUTOIN_RI_STEPARENA_HPP
+#define FUTOIN_RI_STEPARENA_HPP
+//---
+#include <cstddef>
+//---
+#include "../iasyncsteps.hpp"
+#include "../imempool.hpp"
+
+namespace futoin {
+    namespace ri {
+        /**
+         * @brief Bump pointer arena with a destructor list
+         *
+         * It's designed to back IAsyncSteps::stack() of a single step
+         * frame. Allocation is a pointer bump in the current block.
+         * Destroy handlers are recorded in-place and called in reverse
+         * order by release() when the step completes.
+         *
+         * The first block is kept on release() for reuse by the next step
+         * occupying the same frame, unless it's larger than block size due
+         * to an oversized allocation. Blocks are lazily allocated from the
+         * associated IMemPool.
+         */
+        class StepArena
+        {
+        public:
+            using DestroyHandler = IAsyncSteps::StackDestroyHandler;
+
+            static constexpr std::size_t ALIGNMENT = alignof(std::max_align_t);
+            static constexpr std::size_t DEFAULT_BLOCK_SIZE = 512;
+
+            explicit StepArena(
+                    IMemPool& mem_pool = GlobalMemPool::get_default(),
+                    std::size_t block_size = DEFAULT_BLOCK_SIZE) noexcept :
+                mem_pool_(mem_pool), block_size_(block_size)
+            {}
+
+            StepArena(const StepArena&) = delete;
+            StepArena& operator=(const StepArena&) = delete;
+            StepArena(StepArena&&) = delete;
+            StepArena& operator=(StepArena&&) = delete;
+
+            ~StepArena() noexcept
+            {
+                release();
+
+                if (blocks_ != nullptr) {
+                    free_block(blocks_);
+                }
+            }
+
+            /**
+             * @brief Allocate memory with lifetime till release()
+             * @param destroy_cb is called on release(), unless it's
+             *        nullptr or the default no-op handler
+             */
+            void* allocate(
+                    std::size_t object_size,
+                    DestroyHandler destroy_cb = nullptr) noexcept
+            {
+                bool track =
+                        (destroy_cb != nullptr)
+                        && (destroy_cb != &asyncsteps::default_destroy_cb<>);
+                auto need = align(object_size) + (track ? RECORD_SIZE : 0);
+
+                if (need > static_cast<std::size_t>(end_ - ptr_)) {
+                    add_block(need);
+                }
+
+                auto* p = ptr_;
+                ptr_ += need;
+
+                if (track) {
+                    auto* r = reinterpret_cast<Record*>(p);
+                    r->destroy_cb = destroy_cb;
+                    r->prev = records_;
+                    records_ = r;
+                    p += RECORD_SIZE;
+                }
+
+                return p;
+            }
+
+            /**
+             * @brief Destroy all objects and reset arena for reuse
+             */
+            void release() noexcept
+            {
+                while (records_ != nullptr) {
+                    auto* r = records_;
+                    records_ = r->prev;
+                    r->destroy_cb(reinterpret_cast<char*>(r) + RECORD_SIZE);
+                }
+
+                // New blocks go first, so the last one is the oldest
+                Block* keep = nullptr;
+
+                while (blocks_ != nullptr) {
+                    auto* b = blocks_;
+                    blocks_ = b->next;
+
+                    if ((blocks_ == nullptr) && (b->size == block_size_)) {
+                        keep = b;
+                    } else {
+                        free_block(b);
+                    }
+                }
+
+                blocks_ = keep;
+
+                if (keep != nullptr) {
+                    ptr_ = block_data(keep);
+                    end_ = reinterpret_cast<char*>(keep) + keep->size;
+                } else {
+                    ptr_ = nullptr;
+                    end_ = nullptr;
+                }
+            }
+
+            /**
+             * @brief Free the block kept for reuse as well
+             */
+            void release_memory() noexcept
+            {
+                release();
+
+                if (blocks_ != nullptr) {
+                    free_block(blocks_);
+                    blocks_ = nullptr;
+                    ptr_ = nullptr;
+                    end_ = nullptr;
+                }
+            }
+
+            inline IMemPool& mem_pool() const noexcept
+            {
+                return mem_pool_;
+            }
+
+        private:
+            /**
+             * @private
+             */
+            struct Block
+            {
+                Block* next;
+                std::size_t size;
+            };
+
+            /**
+             * @private
+             */
+            struct Record
+            {
+                DestroyHandler destroy_cb;
+                Record* prev;
+            };
+
+            static constexpr std::size_t align(std::size_t size) noexcept
+            {
+                return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+            }
+
+            static constexpr std::size_t BLOCK_HEADER_SIZE =
+                    (sizeof(Block) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+            static constexpr std::size_t RECORD_SIZE =
+                    (sizeof(Record) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+            static inline char* block_data(Block* b) noexcept
+            {
+                return reinterpret_cast<char*>(b) + BLOCK_HEADER_SIZE;
+            }
+
+            void add_block(std::size_t need) noexcept
+            {
+                std::size_t size = BLOCK_HEADER_SIZE + need;
+
+                if (size < block_size_) {
+                    size = block_size_;
+                }
+
+                auto* b =
+                        reinterpret_cast<Block*>(mem_pool_.allocate(1, size));
+                b->next = blocks_;
+                b->size = size;
+                blocks_ = b;
+
+                ptr_ = block_data(b);
+                end_ = reinterpret_cast<char*>(b) + size;
+            }
+
+            void free_block(Block* b) noexcept
+            {
+                mem_pool_.deallocate(b, 1, b->size);
+            }
+
+            IMemPool& mem_pool_;
+            const std::size_t block_size_;
+            Block* blocks_{nullptr};
+            Record* records_{nullptr};
+            char* ptr_{nullptr};
+            char* end_{nullptr};
+        };
+    } // namespace ri
+} // namespace futoin
+
+//---
+#endif // FUTOIN_RI_STEPARENA_HPP
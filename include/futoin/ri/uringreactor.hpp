@@ -0,0 +1,217 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+//! @file
+//! @brief Reference io_uring based reactor for Linux
+//-----------------------------------------------------------------------------
+
+#ifndef FUTOIN_RI_URINGREACTOR_HPP
+#define FUTOIN_RI_URINGREACTOR_HPP
+//---
+#include "../iasyncsteps.hpp"
+#include "reactor.hpp"
+
+#if defined(__linux__) && !defined(FUTOIN_NO_URING)
+#    define FUTOIN_RI_URING 1
+//---
+#    include <array>
+#    include <cstdint>
+
+namespace futoin {
+    namespace ri {
+        /**
+         * @brief ri::Reactor variant sleeping and doing I/O on io_uring
+         *
+         * Timer wheel and queues are the same as in ri::Reactor. Sleep is
+         * a single io_uring_enter() which also submits queued I/O. Wheel
+         * deadline is armed as IORING_OP_TIMEOUT with absolute time, so
+         * it's re-armed only when an earlier deadline appears or after it
+         * fires. A superseded one is removed with IORING_OP_TIMEOUT_REMOVE,
+         * so at most one is armed at a time. wakeup()
+         * eventfd is read by a persistent IORING_OP_READ.
+         *
+         * wakeup_fd() is the ring itself, it's readable when there are
+         * completions including the eventfd read.
+         *
+         * I/O operations complete into IAsyncSteps through waitExternal()
+         * and success(result) or CommError with strerror() info.
+         * Completion callback variants are available for custom use.
+         *
+         * Destructor cancels I/O in flight and waits till the kernel is
+         * done with its buffers. Completion callbacks are called from the
+         * destructor then, usually with -ECANCELED.
+         *
+         * @note If io_uring is not available, it works as plain
+         *       ri::Reactor and I/O operations fail with -ENOSYS.
+         */
+        class UringReactor : public Reactor
+        {
+        public:
+            using IoSignature = void(int);
+            using IoPass = details::functor_pass::Simple<
+                    IoSignature,
+                    details::functor_pass::DEFAULT_SIZE,
+                    details::functor_pass::Function>;
+            using IoCallback = IoPass::Function;
+
+            static constexpr unsigned DEFAULT_ENTRIES = 256;
+            /// Larger read() and write() are clamped like read(2) does
+            static constexpr std::size_t MAX_IO_SIZE = 0x7ffff000;
+
+            explicit UringReactor(
+                    IMemPool& mem_pool = GlobalMemPool::get_default(),
+                    unsigned entries = DEFAULT_ENTRIES) noexcept;
+            ~UringReactor() noexcept override;
+
+            using Reactor::iterate;
+            CycleResult iterate(
+                    const CycleBudget& budget,
+                    CycleStats* stats = nullptr) noexcept override;
+            int wakeup_fd() noexcept override;
+
+            /**
+             * @brief Check if io_uring is in use
+             */
+            inline bool uring_active() const noexcept
+            {
+                return ring_fd_ >= 0;
+            }
+
+            /**
+             * @brief Number of I/O operations in flight
+             */
+            inline std::size_t io_count() const noexcept
+            {
+                return io_count_;
+            }
+
+            /**
+             * @name Completion callback I/O
+             * @note Callback gets result of syscall or negative errno.
+             *       Buffers must stay valid till completion. At most
+             *       MAX_IO_SIZE bytes are transferred at once, so check
+             *       for short results.
+             */
+            ///@{
+            void read(
+                    int fd,
+                    void* buf,
+                    std::size_t len,
+                    std::uint64_t offset,
+                    IoPass&& cb) noexcept;
+            void write(
+                    int fd,
+                    const void* buf,
+                    std::size_t len,
+                    std::uint64_t offset,
+                    IoPass&& cb) noexcept;
+            void accept(int fd, IoPass&& cb) noexcept;
+            ///@}
+
+            /**
+             * @name IAsyncSteps I/O
+             * @note To be called from a step. Step completes with
+             *       success(std::size_t) or success(int) for accept().
+             *       MAX_IO_SIZE limit applies as well.
+             *       Step cancel, timeout or error unwinding submits
+             *       IORING_OP_ASYNC_CANCEL and drops the result.
+             * @note Data goes through a buffer owned by the operation till
+             *       its completion, so buf needs to be valid only while the
+             *       step runs, e.g. stack() is fine. It costs a copy, use
+             *       the callback API to avoid it.
+             */
+            ///@{
+            void read(
+                    IAsyncSteps& asi,
+                    int fd,
+                    void* buf,
+                    std::size_t len,
+                    std::uint64_t offset = ~std::uint64_t(0)) noexcept;
+            void write(
+                    IAsyncSteps& asi,
+                    int fd,
+                    const void* buf,
+                    std::size_t len,
+                    std::uint64_t offset = ~std::uint64_t(0)) noexcept;
+            void accept(IAsyncSteps& asi, int fd) noexcept;
+            ///@}
+
+        protected:
+            void sleep(std::chrono::milliseconds timeout) noexcept override;
+            void drain_wakeup() noexcept override;
+
+        private:
+            struct Op;
+
+            Op* alloc_op(IoPass& cb) noexcept;
+            void free_op(Op* op) noexcept;
+            void* get_sqe() noexcept;
+            void queue_op(
+                    Op* op,
+                    std::uint8_t opcode,
+                    int fd,
+                    const void* addr,
+                    std::size_t len,
+                    std::uint64_t offset) noexcept;
+            void steps_op(
+                    IAsyncSteps& asi,
+                    std::uint8_t opcode,
+                    int fd,
+                    const void* addr,
+                    std::size_t len,
+                    std::uint64_t offset) noexcept;
+            bool cancel_io(std::uint64_t user_data) noexcept;
+            void arm_wakeup() noexcept;
+            void arm_timeout(std::chrono::milliseconds timeout) noexcept;
+            int enter(unsigned min_complete) noexcept;
+            bool reap() noexcept;
+
+            int ring_fd_{-1};
+            void* sq_map_{nullptr};
+            std::size_t sq_map_size_{0};
+            void* cq_map_{nullptr};
+            std::size_t cq_map_size_{0};
+            void* sqes_{nullptr};
+            std::size_t sqes_size_{0};
+
+            // Ring pointers
+            unsigned* sq_head_{nullptr};
+            unsigned* sq_tail_{nullptr};
+            unsigned* sq_mask_{nullptr};
+            unsigned* sq_array_{nullptr};
+            unsigned* cq_head_{nullptr};
+            unsigned* cq_tail_{nullptr};
+            unsigned* cq_mask_{nullptr};
+            void* cqes_{nullptr};
+
+            unsigned to_submit_{0};
+            std::size_t io_count_{0};
+            Op* ops_{nullptr};
+
+            bool closing_{false};
+            bool wakeup_armed_{false};
+            std::uint64_t wakeup_buf_{0};
+            std::uint64_t timeout_armed_{0};
+            std::uint64_t timeout_seq_{0};
+            std::int64_t timeout_deadline_{0};
+            std::array<std::int64_t, 2> timeout_spec_{{0, 0}};
+        };
+    } // namespace ri
+} // namespace futoin
+
+#endif
+//---
+#endif // FUTOIN_RI_URINGREACTOR_HPP
@@ -0,0 +1,1417 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <futoin/ri/asyncsteps.hpp>
+
+#include <mutex>
+#include <new>
+#include <string>
+
+#include <futoin/fatalmsg.hpp>
+#include <futoin/ri/reactorpool.hpp>
+#include <futoin/ri/steparena.hpp>
+
+namespace futoin {
+    namespace ri {
+        namespace {
+            template<typename Storage>
+            inline void reset_storage(Storage& storage) noexcept
+            {
+                storage.set_cleanup(&Storage::default_cleanup);
+            }
+        } // namespace
+
+        //---
+        /**
+         * @private
+         * Queued step, recycled through free list
+         */
+        struct AsyncSteps::Step
+        {
+            StepData data;
+            Step* next{nullptr};
+            LoopNode* loop{nullptr};
+            Frame* parallel{nullptr};
+            ISync* sync{nullptr};
+        };
+
+        /**
+         * @private
+         * Loop state, recycled through free list
+         */
+        struct AsyncSteps::LoopNode
+        {
+            asyncsteps::LoopState state;
+            LoopNode* next{nullptr};
+        };
+
+        /**
+         * @private
+         * Shared by the root and its thread branches
+         */
+        struct AsyncSteps::Hub
+        {
+            // Null after the origin is destroyed
+            AsyncSteps* origin{nullptr};
+            IMemPool* mem_pool{nullptr};
+            std::mutex mutex;
+        };
+
+        /**
+         * @private
+         * Thread branch, runs on a pool worker and joins on the tool
+         */
+        struct AsyncSteps::Branch
+        {
+            /**
+             * @private
+             * Fails the branch, if the pool drops its job or root
+             */
+            struct Owner
+            {
+                explicit Owner(Branch* b) noexcept : b(b) {}
+
+                Owner(const Owner&) = delete;
+                Owner& operator=(const Owner&) = delete;
+
+                ~Owner() noexcept
+                {
+                    if (b != nullptr) {
+                        b->drop();
+                    }
+                }
+
+                Branch* b;
+            };
+
+            void run(IAsyncSteps& asi) noexcept;
+            void finish() noexcept;
+            void drop() noexcept;
+            void join() noexcept;
+            void release() noexcept;
+
+            std::shared_ptr<Hub> hub;
+            Owner* owner{nullptr};
+            IAsyncTool* tool{nullptr};
+            Step* step{nullptr};
+            Frame* frame{nullptr};
+            Branch* next{nullptr};
+            IAsyncTool::Priority priority{IAsyncTool::Priority::Normal};
+            // Not bound to thread default memory pool
+            std::string error;
+            std::string error_info;
+        };
+
+        /**
+         * @private
+         * Marks engine entry, pending cancel runs on the outermost exit
+         */
+        struct AsyncSteps::Guard
+        {
+            explicit Guard(AsyncSteps& root) noexcept : root(root)
+            {
+                ++root.depth_;
+            }
+
+            Guard(const Guard&) = delete;
+            Guard& operator=(const Guard&) = delete;
+
+            ~Guard() noexcept
+            {
+                if (root.depth_ == 1) {
+                    while (root.cancel_pending_) {
+                        root.do_cancel();
+                    }
+                }
+
+                --root.depth_;
+            }
+
+            AsyncSteps& root;
+        };
+
+        /**
+         * @private
+         * Execution frame of a single step, passed to step functions
+         */
+        class AsyncSteps::Frame final : public IAsyncSteps
+        {
+        public:
+            explicit Frame(AsyncSteps& root) noexcept :
+                root(root), arena(root.mem_pool_)
+            {}
+
+            IAsyncSteps& parallel(ErrorPass on_error = {}) noexcept override
+            {
+                return root.push_parallel(*this, on_error);
+            }
+
+            BaseState& state() noexcept override
+            {
+                return root.state_;
+            }
+
+            IAsyncSteps& copyFrom(IAsyncSteps& other) noexcept override
+            {
+                return root.copyFrom(other);
+            }
+
+            SyncRootID sync_root_id() const override
+            {
+                return root.sync_root_id();
+            }
+
+            std::unique_ptr<IAsyncSteps> newInstance() noexcept override
+            {
+                return root.newInstance();
+            }
+
+            void* stack(
+                    std::size_t object_size,
+                    StackDestroyHandler destroy_cb) noexcept override
+            {
+                return arena.allocate(object_size, destroy_cb);
+            }
+
+            FutoInAsyncSteps& binary() noexcept override
+            {
+                return root.binary();
+            }
+
+            std::unique_ptr<IAsyncSteps> wrap(
+                    FutoInAsyncSteps& binary_steps) noexcept override
+            {
+                return root.wrap(binary_steps);
+            }
+
+            IAsyncTool& tool() noexcept override
+            {
+                return root.tool_;
+            }
+
+            void setTimeout(std::chrono::milliseconds to) noexcept override
+            {
+                root.set_timeout(*this, to);
+            }
+
+            void setCancel(CancelPass cb) noexcept override
+            {
+                root.set_cancel(*this, cb);
+            }
+
+            void waitExternal() noexcept override
+            {
+                waiting = true;
+            }
+
+            operator bool() const noexcept override
+            {
+                return active;
+            }
+
+            // Root only
+            void execute() noexcept override {}
+            void cancel() noexcept override {}
+
+            AsyncSteps& root;
+            Frame* parent{nullptr};
+            Frame* prev{nullptr};
+            Frame* next{nullptr};
+            Frame* children{nullptr};
+            Branch* branch{nullptr};
+            Step* step{nullptr};
+            Step* head{nullptr};
+            Step* tail{nullptr};
+            RawErrorCode error{nullptr};
+            std::size_t limit{0};
+            Kind kind{Kind::Step};
+            bool threaded{false};
+            bool active{false};
+            bool started{false};
+            bool locked{false};
+            bool in_call{false};
+            bool in_error{false};
+            bool waiting{false};
+            bool done{false};
+            asyncsteps::CancelCallback on_cancel;
+            CancelPass::Storage on_cancel_storage;
+            IAsyncTool::Handle timeout;
+            IAsyncTool::Handle sched;
+            StepArena arena;
+
+        protected:
+            StepData& add_step() noexcept override
+            {
+                return root.push_step(*this).data;
+            }
+
+            void handle_success() noexcept override
+            {
+                root.on_success(*this);
+            }
+
+            void handle_error(ErrorCode code) noexcept override
+            {
+                root.on_error(*this, code);
+            }
+
+            asyncsteps::NextArgs& nextargs() noexcept override
+            {
+                return root.next_args_;
+            }
+
+            asyncsteps::LoopState& add_loop(
+                    asyncsteps::LoopLabel label) noexcept override
+            {
+                return root.push_loop(*this, label);
+            }
+
+            StepData& add_sync(ISync& obj) noexcept override
+            {
+                return root.push_sync(*this, obj);
+            }
+
+            void await_impl(AwaitPass cb) noexcept override
+            {
+                root.push_await(*this, cb);
+            }
+
+            IAsyncSteps& parallel_impl(
+                    ErrorPass on_error,
+                    ParallelMode mode,
+                    std::size_t limit) noexcept override
+            {
+                return root.push_parallel(*this, on_error, mode, limit);
+            }
+        };
+
+        //---
+        AsyncSteps::AsyncSteps(IAsyncTool& tool) noexcept :
+            tool_(tool), mem_pool_(tool.mem_pool()), state_(mem_pool_)
+        {
+            root_ = alloc_frame();
+            root_->kind = Kind::Root;
+            root_->started = true;
+        }
+
+        AsyncSteps::~AsyncSteps() noexcept
+        {
+            do_cancel();
+            orphan_branches();
+
+            root_->~Frame();
+            mem_pool_.deallocate(root_, sizeof(Frame), 1);
+
+            release_memory();
+        }
+
+        IAsyncSteps& AsyncSteps::parallel(ErrorPass on_error) noexcept
+        {
+            return push_parallel(*root_, on_error);
+        }
+
+        AsyncSteps::BaseState& AsyncSteps::state() noexcept
+        {
+            return state_;
+        }
+
+        IAsyncSteps& AsyncSteps::copyFrom(IAsyncSteps& /*other*/) noexcept
+        {
+            // Queued step functors are move-only
+            FatalMsg() << "ri::AsyncSteps::copyFrom() is not supported!";
+        }
+
+        AsyncSteps::SyncRootID AsyncSteps::sync_root_id() const
+        {
+            return reinterpret_cast<SyncRootID>(this);
+        }
+
+        std::unique_ptr<IAsyncSteps> AsyncSteps::newInstance() noexcept
+        {
+            auto* asi = new AsyncSteps(tool_);
+            asi->thread_pool_ = thread_pool_;
+            asi->inline_depth_ = inline_depth_;
+            return std::unique_ptr<IAsyncSteps>(asi);
+        }
+
+        void* AsyncSteps::stack(
+                std::size_t object_size,
+                StackDestroyHandler destroy_cb) noexcept
+        {
+            return root_->arena.allocate(object_size, destroy_cb);
+        }
+
+        FutoInAsyncSteps& AsyncSteps::binary() noexcept
+        {
+            FatalMsg() << "ri::AsyncSteps::binary() is not supported!";
+        }
+
+        std::unique_ptr<IAsyncSteps> AsyncSteps::wrap(
+                FutoInAsyncSteps& /*binary_steps*/) noexcept
+        {
+            FatalMsg() << "ri::AsyncSteps::wrap() is not supported!";
+        }
+
+        IAsyncTool& AsyncSteps::tool() noexcept
+        {
+            return tool_;
+        }
+
+        void AsyncSteps::setTimeout(std::chrono::milliseconds to) noexcept
+        {
+            set_timeout(*root_, to);
+        }
+
+        void AsyncSteps::setCancel(CancelPass cb) noexcept
+        {
+            set_cancel(*root_, cb);
+        }
+
+        void AsyncSteps::waitExternal() noexcept
+        {
+            root_->waiting = true;
+        }
+
+        AsyncSteps::operator bool() const noexcept
+        {
+            return true;
+        }
+
+        void AsyncSteps::execute() noexcept
+        {
+            if (running_) {
+                return;
+            }
+
+            running_ = true;
+            schedule(root_);
+        }
+
+        void AsyncSteps::cancel() noexcept
+        {
+            if (depth_ != 0) {
+                cancel_pending_ = true;
+                return;
+            }
+
+            Guard guard(*this);
+            do_cancel();
+        }
+
+        void AsyncSteps::release_memory() noexcept
+        {
+            while (auto* s = free_steps_) {
+                free_steps_ = s->next;
+                s->~Step();
+                mem_pool_.deallocate(s, sizeof(Step), 1);
+            }
+
+            while (auto* f = free_frames_) {
+                free_frames_ = f->next;
+                f->~Frame();
+                mem_pool_.deallocate(f, sizeof(Frame), 1);
+            }
+
+            while (auto* n = free_loops_) {
+                free_loops_ = n->next;
+                n->~LoopNode();
+                mem_pool_.deallocate(n, sizeof(LoopNode), 1);
+            }
+        }
+
+        AsyncSteps::StepData& AsyncSteps::add_step() noexcept
+        {
+            return push_step(*root_).data;
+        }
+
+        void AsyncSteps::handle_success() noexcept
+        {
+            on_success(*root_);
+        }
+
+        void AsyncSteps::handle_error(ErrorCode code) noexcept
+        {
+            on_error(*root_, code);
+        }
+
+        asyncsteps::NextArgs& AsyncSteps::nextargs() noexcept
+        {
+            return next_args_;
+        }
+
+        asyncsteps::LoopState& AsyncSteps::add_loop(
+                asyncsteps::LoopLabel label) noexcept
+        {
+            return push_loop(*root_, label);
+        }
+
+        AsyncSteps::StepData& AsyncSteps::add_sync(ISync& obj) noexcept
+        {
+            return push_sync(*root_, obj);
+        }
+
+        void AsyncSteps::await_impl(AwaitPass cb) noexcept
+        {
+            push_await(*root_, cb);
+        }
+
+        IAsyncSteps& AsyncSteps::parallel_impl(
+                ErrorPass on_error,
+                ParallelMode mode,
+                std::size_t limit) noexcept
+        {
+            return push_parallel(*root_, on_error, mode, limit);
+        }
+
+        //---
+        AsyncSteps::Step* AsyncSteps::alloc_step() noexcept
+        {
+            auto* s = free_steps_;
+
+            if (s != nullptr) {
+                free_steps_ = s->next;
+                s->next = nullptr;
+            } else {
+                s = new (mem_pool_.allocate(sizeof(Step), 1)) Step;
+            }
+
+            return s;
+        }
+
+        void AsyncSteps::free_step(Step* s) noexcept
+        {
+            auto& data = s->data;
+            data.func_ = nullptr;
+            data.on_error_ = nullptr;
+            reset_storage(data.func_orig_);
+            reset_storage(data.func_storage_);
+            reset_storage(data.func_orig_storage_);
+            reset_storage(data.on_error_storage_);
+
+            if (s->loop != nullptr) {
+                free_loop(s->loop);
+                s->loop = nullptr;
+            }
+
+            // Parallel frame which has not started yet
+            if (s->parallel != nullptr) {
+                auto* pf = s->parallel;
+                s->parallel = nullptr;
+                pf->step = nullptr;
+                release(pf);
+            }
+
+            s->sync = nullptr;
+            s->next = free_steps_;
+            free_steps_ = s;
+        }
+
+        AsyncSteps::Frame* AsyncSteps::alloc_frame() noexcept
+        {
+            auto* f = free_frames_;
+
+            if (f != nullptr) {
+                free_frames_ = f->next;
+                f->next = nullptr;
+            } else {
+                f = new (mem_pool_.allocate(sizeof(Frame), 1)) Frame(*this);
+            }
+
+            f->active = true;
+            return f;
+        }
+
+        void AsyncSteps::free_frame(Frame* f) noexcept
+        {
+            f->parent = nullptr;
+            f->prev = nullptr;
+            f->children = nullptr;
+            f->branch = nullptr;
+            f->step = nullptr;
+            f->error = nullptr;
+            f->kind = Kind::Step;
+            f->threaded = false;
+            f->limit = 0;
+            f->active = false;
+            f->started = false;
+            f->locked = false;
+            f->in_call = false;
+            f->in_error = false;
+            f->waiting = false;
+            f->done = false;
+            f->on_cancel = nullptr;
+            reset_storage(f->on_cancel_storage);
+            f->timeout.reset();
+            f->sched.reset();
+            f->arena.release();
+
+            f->next = free_frames_;
+            free_frames_ = f;
+        }
+
+        AsyncSteps::LoopNode* AsyncSteps::alloc_loop() noexcept
+        {
+            auto* n = free_loops_;
+
+            if (n != nullptr) {
+                free_loops_ = n->next;
+                n->next = nullptr;
+            } else {
+                n = new (mem_pool_.allocate(sizeof(LoopNode), 1)) LoopNode;
+            }
+
+            return n;
+        }
+
+        void AsyncSteps::free_loop(LoopNode* n) noexcept
+        {
+            auto& ls = n->state;
+            ls.handler = nullptr;
+            ls.cond = nullptr;
+            reset_storage(ls.handler_storage);
+            reset_storage(ls.cond_storage);
+            reset_storage(ls.outer_func_storage);
+            // Iterator may refer to the container
+            ls.data.reset();
+            ls.container_data.reset();
+
+            n->next = free_loops_;
+            free_loops_ = n;
+        }
+
+        //---
+        AsyncSteps::Step& AsyncSteps::push_step(Frame& f) noexcept
+        {
+            auto* s = alloc_step();
+
+            if (f.tail != nullptr) {
+                f.tail->next = s;
+            } else {
+                f.head = s;
+            }
+
+            f.tail = s;
+            return *s;
+        }
+
+        IAsyncSteps& AsyncSteps::push_parallel(
+                Frame& f,
+                ErrorPass& on_error,
+                ParallelMode mode,
+                std::size_t limit) noexcept
+        {
+            auto& s = push_step(f);
+            on_error.move(s.data.on_error_, s.data.on_error_storage_);
+
+            // Branches are queued to the frame in advance
+            auto* pf = alloc_frame();
+            pf->kind = Kind::Parallel;
+            pf->threaded = (mode == ParallelMode::Threads)
+                           && (thread_pool_ != nullptr);
+            pf->limit = limit;
+            pf->step = &s;
+            s.parallel = pf;
+            return *pf;
+        }
+
+        asyncsteps::LoopState& AsyncSteps::push_loop(
+                Frame& f, asyncsteps::LoopLabel label) noexcept
+        {
+            auto& s = push_step(f);
+            s.loop = alloc_loop();
+
+            auto& ls = s.loop->state;
+            ls.i = 0;
+            ls.label = label;
+            return ls;
+        }
+
+        AsyncSteps::StepData& AsyncSteps::push_sync(
+                Frame& f, ISync& obj) noexcept
+        {
+            auto& s = push_step(f);
+            s.sync = &obj;
+            return s.data;
+        }
+
+        void AsyncSteps::push_await(Frame& f, AwaitPass& cb) noexcept
+        {
+            using asyncsteps::AwaitCallback;
+            using asyncsteps::LoopState;
+
+            // Poll with relinquish() till the future is ready
+            auto& ls = push_loop(f, nullptr);
+            AwaitCallback await_cb;
+            cb.move(await_cb, ls.outer_func_storage);
+            ls.data = any(await_cb);
+
+            ls.set_handler([](LoopState& ls, IAsyncSteps& asi) {
+                auto& await_cb = any_cast<AwaitCallback&>(ls.data);
+
+                if (await_cb(asi, std::chrono::milliseconds(0), true)) {
+                    ls.i = 1;
+                }
+            });
+            ls.set_cond([](LoopState& ls) { return ls.i == 0; });
+        }
+
+        void AsyncSteps::set_timeout(
+                Frame& f, std::chrono::milliseconds to) noexcept
+        {
+            auto* fp = &f;
+
+            f.timeout.cancel();
+            f.timeout = tool_.deferred(to, [this, fp]() {
+                Guard guard(*this);
+                fail(fp, errors::Timeout);
+            });
+            f.waiting = true;
+        }
+
+        void AsyncSteps::set_cancel(Frame& f, CancelPass& cb) noexcept
+        {
+            f.on_cancel = nullptr;
+            reset_storage(f.on_cancel_storage);
+            cb.move(f.on_cancel, f.on_cancel_storage);
+            f.waiting = true;
+        }
+
+        void AsyncSteps::on_success(Frame& f) noexcept
+        {
+            if (!f.active) {
+                return;
+            }
+
+            if (f.in_call) {
+                f.done = true;
+                return;
+            }
+
+            // Only a step without running sub-steps may complete
+            if ((f.children != nullptr) || (f.kind == Kind::Root)) {
+                return;
+            }
+
+            // Not returned from a step function, so never inline
+            Guard guard(*this);
+            const auto inline_level = inline_level_;
+            inline_level_ = inline_depth_;
+            complete(&f);
+            inline_level_ = inline_level;
+        }
+
+        void AsyncSteps::on_error(Frame& f, ErrorCode code) noexcept
+        {
+            if (!f.active) {
+                return;
+            }
+
+            if (f.in_call) {
+                if (f.error == nullptr) {
+                    f.error = code;
+                }
+
+                return;
+            }
+
+            Guard guard(*this);
+            const auto inline_level = inline_level_;
+            inline_level_ = inline_depth_;
+            fail(&f, code);
+            inline_level_ = inline_level;
+        }
+
+        //---
+        AsyncSteps::Frame* AsyncSteps::add_child(
+                Frame* parent, Step* s, Kind kind) noexcept
+        {
+            auto* f = (kind == Kind::Parallel) ? s->parallel : alloc_frame();
+
+            f->parent = parent;
+            f->step = s;
+            f->kind = kind;
+            f->next = parent->children;
+
+            if (parent->children != nullptr) {
+                parent->children->prev = f;
+            }
+
+            parent->children = f;
+            return f;
+        }
+
+        AsyncSteps::Step* AsyncSteps::pop_step(Frame* f) noexcept
+        {
+            auto* s = f->head;
+
+            if (s != nullptr) {
+                f->head = s->next;
+                s->next = nullptr;
+
+                if (f->head == nullptr) {
+                    f->tail = nullptr;
+                }
+            }
+
+            return s;
+        }
+
+        void AsyncSteps::launch(Frame* f) noexcept
+        {
+            auto* s = pop_step(f);
+            Kind kind = Kind::Step;
+
+            if (s->loop != nullptr) {
+                kind = Kind::Loop;
+            } else if (s->parallel != nullptr) {
+                kind = Kind::Parallel;
+            } else if (f->threaded && (s->sync == nullptr)) {
+                spawn(add_child(f, s, Kind::Thread));
+                return;
+            }
+
+            // Branches are interleaved, never inline
+            post(add_child(f, s, kind));
+        }
+
+        void AsyncSteps::schedule(Frame* f) noexcept
+        {
+            if (f->sched) {
+                return;
+            }
+
+            if ((depth_ == 0) || (inline_level_ >= inline_depth_)) {
+                post(f);
+                return;
+            }
+
+            // Everything is aborted on the outermost engine exit
+            if (cancel_pending_) {
+                return;
+            }
+
+            ++inline_level_;
+            proceed(f);
+            --inline_level_;
+        }
+
+        void AsyncSteps::post(Frame* f) noexcept
+        {
+            if (f->sched) {
+                return;
+            }
+
+            f->sched = tool_.immediate_priority(state_.priority(), [this, f]() {
+                Guard guard(*this);
+                f->sched.reset();
+                proceed(f);
+            });
+        }
+
+        void AsyncSteps::proceed(Frame* f) noexcept
+        {
+            if (!f->started) {
+                auto* s = f->step;
+
+                if ((s != nullptr) && (s->sync != nullptr) && !f->locked) {
+                    // Lock is acquired in a sub-frame
+                    run(add_child(f, nullptr, Kind::Lock));
+                    return;
+                }
+
+                f->started = true;
+                start(f);
+                return;
+            }
+
+            resume(f);
+        }
+
+        void AsyncSteps::start(Frame* f) noexcept
+        {
+            switch (f->kind) {
+            case Kind::Loop:
+                loop_next(f);
+                break;
+
+            case Kind::Parallel: {
+                // The rest is launched as active branches complete
+                std::size_t count = 0;
+
+                while ((f->head != nullptr)
+                       && ((f->limit == 0) || (count < f->limit))) {
+                    launch(f);
+                    ++count;
+                }
+
+                if (f->children == nullptr) {
+                    complete(f);
+                }
+                break;
+            }
+
+            default:
+                run(f);
+                break;
+            }
+        }
+
+        void AsyncSteps::resume(Frame* f) noexcept
+        {
+            switch (f->kind) {
+            case Kind::Loop:
+                loop_next(f);
+                return;
+
+            case Kind::Parallel:
+                if (f->children == nullptr) {
+                    complete(f);
+                }
+                return;
+
+            default:
+                break;
+            }
+
+            auto* s = pop_step(f);
+
+            if (s == nullptr) {
+                complete(f);
+                return;
+            }
+
+            Kind kind = Kind::Step;
+
+            if (s->loop != nullptr) {
+                kind = Kind::Loop;
+            } else if (s->parallel != nullptr) {
+                kind = Kind::Parallel;
+            }
+
+            proceed(add_child(f, s, kind));
+        }
+
+        void AsyncSteps::loop_next(Frame* f) noexcept
+        {
+            auto& ls = f->step->loop->state;
+
+            if (ls.cond && !ls.cond(ls)) {
+                complete(f);
+                return;
+            }
+
+            auto* it = add_child(f, nullptr, Kind::Iteration);
+            it->started = true;
+            run(it);
+        }
+
+        void AsyncSteps::run(Frame* f) noexcept
+        {
+            switch (f->kind) {
+            case Kind::Iteration: {
+                auto& ls = f->parent->step->loop->state;
+                invoke(*f, [&]() { ls.handler(ls, *f); });
+                break;
+            }
+
+            case Kind::Lock: {
+                auto* sync = f->parent->step->sync;
+                invoke(*f, [&]() { sync->lock(*f); });
+                break;
+            }
+
+            default: {
+                auto& func = f->step->data.func_;
+
+                if (func) {
+                    invoke(*f, [&]() { func(*f); });
+                }
+                break;
+            }
+            }
+
+            after_call(f);
+        }
+
+        template<typename Fn>
+        void AsyncSteps::invoke(Frame& f, const Fn& fn) noexcept
+        {
+            f.in_call = true;
+
+#ifndef FUTOIN_NO_EXC
+            try {
+                fn();
+            } catch (const asyncsteps::UnwindException&) {
+                // Already reported by errorNoThrow()
+            } catch (const Error& e) {
+                state_.catch_trace(e);
+
+                if (f.error == nullptr) {
+                    exc_code_ = e.what();
+                    f.error = exc_code_.c_str();
+                }
+            } catch (const ExtError& e) {
+                state_.catch_trace(e);
+
+                if (f.error == nullptr) {
+                    exc_code_ = e.what();
+                    f.error = exc_code_.c_str();
+                    state_.set_error_info(ErrorMessage(e.error_info()));
+                }
+            } catch (const std::exception& e) {
+                state_.catch_trace(e);
+
+                if (f.error == nullptr) {
+                    f.error = errors::InternalError;
+                    state_.set_error_info(e.what());
+                }
+            } catch (...) {
+                if (f.error == nullptr) {
+                    f.error = errors::InternalError;
+                }
+            }
+#else
+            fn();
+#endif
+
+            f.in_call = false;
+        }
+
+        void AsyncSteps::after_call(Frame* f) noexcept
+        {
+            if (cancel_pending_) {
+                return;
+            }
+
+            if (f->error != nullptr) {
+                auto code = f->error;
+                f->error = nullptr;
+                fail(f, code);
+            } else if (f->done) {
+                complete(f);
+            } else if (f->head != nullptr) {
+                schedule(f);
+            } else if (!f->waiting) {
+                // Implicit success
+                complete(f);
+            }
+        }
+
+        void AsyncSteps::complete(Frame* f) noexcept
+        {
+            if (f->kind == Kind::Root) {
+                finish();
+                f->arena.release();
+                return;
+            }
+
+            auto* parent = f->parent;
+
+            if (f->kind == Kind::Lock) {
+                parent->locked = true;
+            }
+
+            release(f);
+
+            // Parallel completes with the last branch
+            if (parent->kind == Kind::Parallel) {
+                if (parent->head != nullptr) {
+                    launch(parent);
+                }
+
+                if (parent->children != nullptr) {
+                    return;
+                }
+            }
+
+            schedule(parent);
+        }
+
+        void AsyncSteps::fail(Frame* f, ErrorCode code) noexcept
+        {
+            for (;;) {
+                abort_children(f);
+                drop_queue(f);
+                f->timeout.cancel();
+                cancel_external(f);
+                f->error = nullptr;
+                f->waiting = false;
+                f->done = false;
+
+                if ((f->kind == Kind::Loop) && loop_control(f, code)) {
+                    return;
+                }
+
+                auto* s = f->step;
+
+                if (!f->in_error && (s != nullptr) && s->data.on_error_) {
+                    auto& handler = s->data.on_error_;
+                    f->in_error = true;
+
+                    // Branches are gone, recovery runs as a regular step
+                    if (f->kind == Kind::Parallel) {
+                        f->kind = Kind::Step;
+                    }
+
+                    invoke(*f, [&]() { handler(*f, code); });
+
+                    if (cancel_pending_) {
+                        return;
+                    }
+
+                    if (f->error != nullptr) {
+                        // Error from the handler goes to the parent
+                        code = f->error;
+                        f->error = nullptr;
+                    } else if (f->done) {
+                        complete(f);
+                        return;
+                    } else if (f->head != nullptr) {
+                        schedule(f);
+                        return;
+                    } else if (f->waiting) {
+                        return;
+                    }
+                }
+
+                if (f->kind == Kind::Root) {
+                    finish();
+                    state_.unhandled_error(code);
+
+                    // The handler may start the next execution
+                    if (!running_) {
+                        f->arena.release();
+                    }
+
+                    return;
+                }
+
+                auto* parent = f->parent;
+                release(f);
+                f = parent;
+            }
+        }
+
+        bool AsyncSteps::loop_control(Frame* f, ErrorCode code) noexcept
+        {
+            const bool is_break = (code == errors::LoopBreak);
+
+            if (!is_break && (code != errors::LoopCont)) {
+                return false;
+            }
+
+            // Empty label is for the innermost loop
+            const auto& label = state_.error_info();
+            auto* own_label = f->step->loop->state.label;
+
+            if (!label.empty()
+                && ((own_label == nullptr) || (label != own_label))) {
+                return false;
+            }
+
+            if (is_break) {
+                complete(f);
+            } else {
+                schedule(f);
+            }
+
+            return true;
+        }
+
+        void AsyncSteps::abort(Frame* f) noexcept
+        {
+            abort_children(f);
+            cancel_external(f);
+            release(f);
+        }
+
+        void AsyncSteps::cancel_external(Frame* f) noexcept
+        {
+            if (!f->on_cancel) {
+                return;
+            }
+
+            // Completion calls from the handler are ignored
+            f->in_call = true;
+
+            if (f->kind == Kind::Root) {
+                f->on_cancel(*this);
+            } else {
+                f->on_cancel(*f);
+            }
+
+            f->in_call = false;
+            f->on_cancel = nullptr;
+        }
+
+        void AsyncSteps::abort_children(Frame* f) noexcept
+        {
+            while (auto* c = f->children) {
+                abort(c);
+            }
+        }
+
+        void AsyncSteps::drop_queue(Frame* f) noexcept
+        {
+            while (auto* s = pop_step(f)) {
+                free_step(s);
+            }
+        }
+
+        void AsyncSteps::release(Frame* f) noexcept
+        {
+            drop_queue(f);
+            f->timeout.cancel();
+            f->sched.cancel();
+
+            if (f->locked) {
+                f->locked = false;
+                f->step->sync->unlock(*f);
+            }
+
+            auto* parent = f->parent;
+
+            if (parent != nullptr) {
+                if (f->prev != nullptr) {
+                    f->prev->next = f->next;
+                } else {
+                    parent->children = f->next;
+                }
+
+                if (f->next != nullptr) {
+                    f->next->prev = f->prev;
+                }
+            }
+
+            if (f->branch != nullptr) {
+                detach(f);
+            }
+
+            if (f->step != nullptr) {
+                f->step->parallel = nullptr;
+                free_step(f->step);
+            }
+
+            free_frame(f);
+        }
+
+        void AsyncSteps::finish() noexcept
+        {
+            auto* f = root_;
+            f->timeout.cancel();
+            f->sched.cancel();
+            f->on_cancel = nullptr;
+            reset_storage(f->on_cancel_storage);
+            f->waiting = false;
+            f->done = false;
+            running_ = false;
+        }
+
+        void AsyncSteps::do_cancel() noexcept
+        {
+            cancel_pending_ = false;
+
+            auto* f = root_;
+            abort_children(f);
+            drop_queue(f);
+
+            if (!running_) {
+                finish();
+                return;
+            }
+
+            cancel_external(f);
+            finish();
+            f->arena.release();
+        }
+
+        //---
+        void AsyncSteps::spawn(Frame* f) noexcept
+        {
+            if (!hub_) {
+                hub_ = std::make_shared<Hub>();
+                hub_->origin = this;
+                hub_->mem_pool = &mem_pool_;
+            }
+
+            auto* b = new Branch;
+            b->hub = hub_;
+            b->tool = &tool_;
+            b->step = f->step;
+            b->frame = f;
+            b->priority = state_.priority();
+
+            f->branch = b;
+            f->started = true;
+            f->waiting = true;
+
+            // Till the branch root takes over
+            auto owner = std::make_shared<Branch::Owner>(b);
+
+            thread_pool_->submit_steps([owner](IAsyncSteps& asi) {
+                auto* b = owner->b;
+                owner->b = nullptr;
+                b->run(asi);
+            });
+        }
+
+        void AsyncSteps::join(Branch* b) noexcept
+        {
+            Guard guard(*this);
+            auto* f = b->frame;
+
+            if (f == nullptr) {
+                auto** pp = &detached_;
+
+                while (*pp != b) {
+                    pp = &(*pp)->next;
+                }
+
+                *pp = b->next;
+
+                free_step(b->step);
+                delete b;
+                return;
+            }
+
+            f->branch = nullptr;
+
+            if (b->error.empty()) {
+                delete b;
+                complete(f);
+                return;
+            }
+
+            exc_code_.assign(b->error.data(), b->error.size());
+            state_.set_error_info(to_futoin(b->error_info));
+            delete b;
+
+            // on_error of the step has already run in the branch
+            f->in_error = true;
+            fail(f, exc_code_.c_str());
+        }
+
+        void AsyncSteps::detach(Frame* f) noexcept
+        {
+            // Step is still in use by the branch till join
+            auto* b = f->branch;
+            f->branch = nullptr;
+            f->step = nullptr;
+
+            b->frame = nullptr;
+            b->next = detached_;
+            detached_ = b;
+        }
+
+        void AsyncSteps::orphan_branches() noexcept
+        {
+            if (!hub_) {
+                return;
+            }
+
+            // Never block, a branch may be queued to this very thread
+            {
+                std::lock_guard<std::mutex> lock(hub_->mutex);
+                hub_->origin = nullptr;
+            }
+
+            // Detached branches release own steps on finish
+            detached_ = nullptr;
+        }
+
+        //---
+        void AsyncSteps::Branch::run(IAsyncSteps& asi) noexcept
+        {
+            auto* b = this;
+            asi.state().set_priority(priority);
+            owner = &asi.stack<Owner>(b);
+
+            asi.add(
+                    [b](IAsyncSteps& asi) {
+                        auto func = [b](IAsyncSteps& asi) {
+                            b->step->data.func_(asi);
+                        };
+
+                        if (!b->step->data.on_error_) {
+                            asi.add(std::move(func));
+                            return;
+                        }
+
+                        asi.add(std::move(func),
+                                [b](IAsyncSteps& asi, ErrorCode code) {
+                                    b->step->data.on_error_(asi, code);
+                                });
+                    },
+                    [b](IAsyncSteps& asi, ErrorCode code) {
+                        b->error = static_cast<RawErrorCode>(code);
+                        b->error_info = to_std(asi.state().error_info());
+                        asi.success();
+                    });
+            asi.add([b](IAsyncSteps&) { b->finish(); });
+        }
+
+        void AsyncSteps::Branch::finish() noexcept
+        {
+            if (owner != nullptr) {
+                owner->b = nullptr;
+                owner = nullptr;
+            }
+
+            // Branch may be gone right after the post
+            auto hub_ref = hub;
+            auto* b = this;
+            std::lock_guard<std::mutex> lock(hub_ref->mutex);
+
+            // Origin and so its tool are alive while locked
+            if (hub_ref->origin != nullptr) {
+                tool->immediate([b]() { b->join(); });
+            } else {
+                release();
+            }
+        }
+
+        void AsyncSteps::Branch::drop() noexcept
+        {
+            owner = nullptr;
+            error = errors::InternalError;
+            error_info = "ReactorPool dropped thread branch";
+            finish();
+        }
+
+        void AsyncSteps::Branch::join() noexcept
+        {
+            auto* origin = hub->origin;
+
+            if (origin != nullptr) {
+                origin->join(this);
+            } else {
+                release();
+            }
+        }
+
+        void AsyncSteps::Branch::release() noexcept
+        {
+            // Origin is gone, so the step is not in its free list
+            if (step != nullptr) {
+                step->~Step();
+                hub->mem_pool->deallocate(step, sizeof(Step), 1);
+            }
+
+            delete this;
+        }
+    } // namespace ri
+} // namespace futoin
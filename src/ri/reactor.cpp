@@ -0,0 +1,1053 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <futoin/ri/reactor.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <new>
+
+#ifdef __linux__
+#    include <poll.h>
+#    include <sys/eventfd.h>
+#    include <unistd.h>
+#endif
+
+namespace futoin {
+    namespace ri {
+        namespace {
+            constexpr Reactor::Tick WHEEL_MASK = Reactor::WHEEL_SIZE - 1;
+            constexpr Reactor::Tick MAX_DELTA =
+                    (Reactor::Tick(1)
+                     << (Reactor::WHEEL_BITS * Reactor::WHEEL_LEVELS))
+                    - 1;
+
+            inline std::size_t count_trailing_zeros(std::uint64_t v) noexcept
+            {
+#if defined(__GNUC__)
+                return static_cast<std::size_t>(__builtin_ctzll(v));
+#else
+                std::size_t res = 0;
+
+                for (; (v & 1U) == 0; v >>= 1U) {
+                    ++res;
+                }
+
+                return res;
+#endif
+            }
+        } // namespace
+
+        //---
+        struct Reactor::Slot : InternalHandle
+        {
+            Slot* prev{nullptr};
+            Slot* next{nullptr};
+            SlotList* owner{nullptr};
+            Tick expire{0};
+            std::size_t cycle{0};
+            std::uint16_t level{0};
+            std::uint16_t bucket{0};
+        };
+
+        struct Reactor::SlotChunk
+        {
+            SlotChunk* next{nullptr};
+            std::array<Slot, SLOT_CHUNK> slots;
+        };
+
+        struct Reactor::InboxNode : InboxLink
+        {
+            InboxNode(IMemPool& mem_pool) noexcept : mem_pool(mem_pool) {}
+
+            IMemPool& mem_pool;
+            Callback callback;
+            CallbackPass::Storage storage;
+            Clock::time_point when;
+            std::chrono::milliseconds delay{0};
+            bool deferred{false};
+            Priority prio{Priority::Normal};
+        };
+
+        /**
+         * @private
+         * Adapter to run inbox callback from a slot, frees node when done
+         */
+        struct Reactor::InboxCall
+        {
+            InboxCall(Reactor* reactor, InboxNode* node) noexcept :
+                reactor(reactor), node(node)
+            {}
+
+            InboxCall(InboxCall&& other) noexcept :
+                reactor(other.reactor), node(other.node)
+            {
+                other.node = nullptr;
+            }
+
+            InboxCall(const InboxCall&) = delete;
+            InboxCall& operator=(const InboxCall&) = delete;
+            InboxCall& operator=(InboxCall&&) = delete;
+
+            ~InboxCall() noexcept
+            {
+                if (node != nullptr) {
+                    reactor->free_node(node);
+                }
+            }
+
+            void operator()() const
+            {
+                node->callback();
+            }
+
+            Reactor* reactor;
+            InboxNode* node;
+        };
+
+        //---
+        void Reactor::SlotList::push_back(Slot* s) noexcept
+        {
+            s->owner = this;
+            s->next = nullptr;
+            s->prev = tail;
+
+            if (tail != nullptr) {
+                tail->next = s;
+            } else {
+                head = s;
+            }
+
+            tail = s;
+            ++size;
+        }
+
+        void Reactor::SlotList::remove(Slot* s) noexcept
+        {
+            if (s->prev != nullptr) {
+                s->prev->next = s->next;
+            } else {
+                head = s->next;
+            }
+
+            if (s->next != nullptr) {
+                s->next->prev = s->prev;
+            } else {
+                tail = s->prev;
+            }
+
+            s->owner = nullptr;
+            s->prev = nullptr;
+            s->next = nullptr;
+            --size;
+        }
+
+        Reactor::Slot* Reactor::SlotList::pop_front() noexcept
+        {
+            auto* s = head;
+
+            if (s != nullptr) {
+                remove(s);
+            }
+
+            return s;
+        }
+
+        //---
+        namespace {
+            template<typename Level>
+            inline void set_used(Level& l, std::size_t idx) noexcept
+            {
+                l.used[idx / 64] |= std::uint64_t(1) << (idx % 64);
+            }
+
+            template<typename Level>
+            inline void clear_used(Level& l, std::size_t idx) noexcept
+            {
+                l.used[idx / 64] &= ~(std::uint64_t(1) << (idx % 64));
+            }
+
+            /**
+             * @brief Find first used bucket starting from idx
+             * @return WHEEL_SIZE, if none
+             */
+            template<typename Level>
+            inline std::size_t find_used(
+                    const Level& l, std::size_t from) noexcept
+            {
+                for (auto w = from / 64; w < l.used.size(); ++w) {
+                    auto bits = l.used[w];
+
+                    if (w == from / 64) {
+                        bits &= ~std::uint64_t(0) << (from % 64);
+                    }
+
+                    if (bits != 0) {
+                        return w * 64 + count_trailing_zeros(bits);
+                    }
+                }
+
+                return Reactor::WHEEL_SIZE;
+            }
+        } // namespace
+
+        //---
+        Reactor::Reactor(IMemPool& mem_pool) noexcept :
+            mem_pool_(mem_pool),
+            owner_(std::this_thread::get_id()),
+            start_(Clock::now())
+        {
+#ifdef __linux__
+            event_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+#endif
+        }
+
+        Reactor::~Reactor() noexcept
+        {
+            while (auto* n = inbox_pop()) {
+                free_node(n);
+            }
+
+            for (auto& l : lanes_) {
+                while (auto* s = l.pop_front()) {
+                    free_slot(s);
+                }
+            }
+
+            for (auto& l : wheel_) {
+                for (auto& b : l.buckets) {
+                    while (auto* s = b.pop_front()) {
+                        free_slot(s);
+                    }
+                }
+            }
+
+            while (chunks_ != nullptr) {
+                auto* c = chunks_;
+                chunks_ = c->next;
+                c->~SlotChunk();
+                mem_pool_.deallocate(c, sizeof(SlotChunk), 1);
+            }
+
+#ifdef __linux__
+            if (event_fd_ >= 0) {
+                ::close(event_fd_);
+            }
+#endif
+        }
+
+        //---
+        Reactor::Handle Reactor::immediate(CallbackPass&& cb) noexcept
+        {
+            return Reactor::immediate_priority(Priority::Normal, std::move(cb));
+        }
+
+        Reactor::Handle Reactor::immediate_priority(
+                Priority prio, CallbackPass&& cb) noexcept
+        {
+            if (!is_same_thread()) {
+                return post(cb, std::chrono::milliseconds(0), false, prio);
+            }
+
+            auto* s = alloc_slot(cb);
+            lane(prio).push_back(s);
+            return make_handle(s);
+        }
+
+        Reactor::Handle Reactor::deferred(
+                std::chrono::milliseconds delay, CallbackPass&& cb) noexcept
+        {
+            using std::chrono::milliseconds;
+
+            if (delay.count() < 0) {
+                delay = milliseconds(0);
+            }
+
+            if (!is_same_thread()) {
+                return post(cb, delay, true);
+            }
+
+            auto* s = alloc_slot(cb);
+            s->expire = expire_tick(now() + delay, delay);
+            insert_timer(s);
+            return make_handle(s);
+        }
+
+        void Reactor::immediate_batch(
+                CallbackPass* cbs, std::size_t count, Handle* handles) noexcept
+        {
+            if (count == 0) {
+                return;
+            }
+
+            if (!is_same_thread()) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    post(cbs[i],
+                         std::chrono::milliseconds(0),
+                         false,
+                         Priority::Normal);
+
+                    if (handles != nullptr) {
+                        handles[i].reset();
+                    }
+                }
+
+                return;
+            }
+
+            reserve_slots(count);
+
+            // Link as one chain and splice to the FIFO tail
+            auto& fifo = lane(Priority::Normal);
+            auto* tail = fifo.tail;
+
+            for (std::size_t i = 0; i < count; ++i) {
+                auto* s = alloc_slot(cbs[i]);
+                s->owner = &fifo;
+                s->prev = tail;
+
+                if (tail != nullptr) {
+                    tail->next = s;
+                } else {
+                    fifo.head = s;
+                }
+
+                tail = s;
+
+                if (handles != nullptr) {
+                    handles[i] = make_handle(s);
+                }
+            }
+
+            fifo.tail = tail;
+            fifo.size += count;
+        }
+
+        bool Reactor::is_same_thread() noexcept
+        {
+            return owner_ == std::this_thread::get_id();
+        }
+
+        Reactor::CycleResult Reactor::iterate() noexcept
+        {
+            return iterate(CycleBudget());
+        }
+
+        Reactor::CycleResult Reactor::iterate(
+                const CycleBudget& budget, CycleStats* stats) noexcept
+        {
+            using std::chrono::milliseconds;
+
+            const bool timed = (budget.time_slice.count() > 0);
+            Clock::time_point started;
+
+            if (timed || (stats != nullptr)) {
+                started = now();
+            }
+
+            const auto deadline = started + budget.time_slice;
+
+            waiting_.store(false, std::memory_order_relaxed);
+            drain_wakeup();
+            drain_inbox();
+            const auto ready = immediate_count();
+            advance(now_tick());
+            const auto expired = immediate_count() - ready;
+
+            // Callbacks scheduled meanwhile are left for the next cycle,
+            // cancel() of the snapshot ones reduces the quota.
+            auto single = PRIORITY_COUNT;
+            bool multi = false;
+
+            for (std::size_t i = 0; i < PRIORITY_COUNT; ++i) {
+                quota_[i] = lanes_[i].size;
+
+                if (quota_[i] != 0) {
+                    multi = (single != PRIORITY_COUNT);
+                    single = i;
+                }
+            }
+
+            if (multi) {
+                single = PRIORITY_COUNT;
+            } else {
+                lane_skips_.fill(0);
+            }
+
+            ++cycle_;
+            std::size_t done = 0;
+
+            while (done < budget.max_callbacks) {
+                Slot* s;
+
+                // No lane arbitration, if only one is due
+                if (single != PRIORITY_COUNT) {
+                    if (quota_[single] == 0) {
+                        break;
+                    }
+
+                    --quota_[single];
+                    s = lanes_[single].pop_front();
+                } else {
+                    s = pop_ready();
+
+                    if (s == nullptr) {
+                        break;
+                    }
+                }
+
+                // Handle is not valid during own callback
+                ++(s->generation);
+                s->callback();
+                free_slot(s);
+                ++done;
+
+                if (timed && (now() >= deadline)) {
+                    break;
+                }
+            }
+
+            if (stats != nullptr) {
+                stats->callbacks = done;
+                stats->expired = expired;
+                stats->pending = immediate_count();
+                stats->elapsed =
+                        std::chrono::duration_cast<std::chrono::microseconds>(
+                                now() - started);
+            }
+
+            bool exhausted = false;
+
+            for (auto& q : quota_) {
+                exhausted = exhausted || (q != 0);
+                q = 0;
+            }
+
+            if (stats != nullptr) {
+                stats->exhausted = exhausted;
+            }
+
+            // Posts after this point signal wakeup_fd()
+            if ((immediate_count() != 0) || !arm_waiting()) {
+                return {true, milliseconds(0)};
+            }
+
+            if (timer_count_ == 0) {
+                return {false, milliseconds(0)};
+            }
+
+            auto wakeup = next_wakeup();
+            auto tick = now_tick();
+
+            return {true, milliseconds((wakeup > tick) ? (wakeup - tick) : 0)};
+        }
+
+        int Reactor::wakeup_fd() noexcept
+        {
+            return event_fd_;
+        }
+
+        Reactor::Clock::time_point Reactor::next_deadline() noexcept
+        {
+            if ((immediate_count() != 0) || !inbox_empty()) {
+                return now();
+            }
+
+            if (timer_count_ == 0) {
+                return Clock::time_point::max();
+            }
+
+            return start_ + std::chrono::milliseconds(next_wakeup());
+        }
+
+        IMemPool& Reactor::mem_pool(
+                std::size_t object_size, bool optimize) noexcept
+        {
+            return mem_pool_.mem_pool(object_size, optimize);
+        }
+
+        void Reactor::release_memory() noexcept
+        {
+            mem_pool_.release_memory();
+        }
+
+        void Reactor::set_timer_slack(
+                std::chrono::milliseconds slack) noexcept
+        {
+            timer_slack_ =
+                    (slack.count() > 0) ? static_cast<Tick>(slack.count()) : 0;
+        }
+
+        void Reactor::set_lane_burst(std::size_t burst) noexcept
+        {
+            lane_burst_ = (burst > 0) ? burst : 1;
+        }
+
+        void Reactor::bind_thread() noexcept
+        {
+            owner_ = std::this_thread::get_id();
+        }
+
+        void Reactor::run() noexcept
+        {
+            for (;;) {
+                auto res = iterate();
+
+                if (!res.have_work) {
+                    break;
+                }
+
+                if (res.delay.count() > 0) {
+                    wait(res.delay);
+                }
+            }
+        }
+
+        void Reactor::wakeup() noexcept
+        {
+#ifdef __linux__
+            if (event_fd_ >= 0) {
+                std::uint64_t v = 1;
+                auto res = ::write(event_fd_, &v, sizeof(v));
+                (void) res;
+                // Only after write, so drain never misses a readable fd
+                signalled_.store(true);
+                return;
+            }
+#endif
+
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex_);
+                woken_ = true;
+            }
+
+            wake_cv_.notify_one();
+        }
+
+        void Reactor::wait(std::chrono::milliseconds timeout) noexcept
+        {
+            if (arm_waiting()) {
+                sleep(timeout);
+            }
+
+            waiting_.store(false);
+        }
+
+        void Reactor::drain_wakeup() noexcept
+        {
+#ifdef __linux__
+            // Clear before read, so a concurrent signal is never lost
+            if ((event_fd_ >= 0)
+                && signalled_.load(std::memory_order_relaxed)
+                && signalled_.exchange(false)) {
+                std::uint64_t v;
+                auto res = ::read(event_fd_, &v, sizeof(v));
+                (void) res;
+            }
+#endif
+        }
+
+        void Reactor::sleep(std::chrono::milliseconds timeout) noexcept
+        {
+#ifdef __linux__
+            if (event_fd_ >= 0) {
+                const auto max_ms = std::numeric_limits<int>::max();
+                auto ms = (timeout.count() < 0)
+                                  ? -1
+                                  : static_cast<int>(std::min<std::int64_t>(
+                                          timeout.count(), max_ms));
+                pollfd pfd{event_fd_, POLLIN, 0};
+
+                if ((::poll(&pfd, 1, ms) > 0)
+                    && ((pfd.revents & POLLIN) != 0)) {
+                    // Readable regardless of the flag, clear it before read
+                    signalled_.store(false);
+                    std::uint64_t v;
+                    auto res = ::read(event_fd_, &v, sizeof(v));
+                    (void) res;
+                }
+
+                return;
+            }
+#endif
+
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            auto pred = [this]() { return woken_; };
+
+            if (timeout.count() < 0) {
+                wake_cv_.wait(lock, pred);
+            } else {
+                wake_cv_.wait_for(lock, timeout, pred);
+            }
+
+            woken_ = false;
+        }
+
+        //---
+        void Reactor::cancel(Handle& h) noexcept
+        {
+            auto* s = handle_slot(h);
+
+            if (s != nullptr) {
+                if (is_lane(s->owner)) {
+                    auto& q = quota_[s->owner - lanes_.data()];
+
+                    // Part of the running cycle snapshot
+                    if ((q != 0) && (s->cycle != cycle_)) {
+                        --q;
+                    }
+
+                    s->owner->remove(s);
+                } else {
+                    remove_timer(s);
+                }
+
+                free_slot(s);
+            }
+
+            HandleAccessor(h).internal() = nullptr;
+        }
+
+        //---
+        bool Reactor::is_lane(const SlotList* l) const noexcept
+        {
+            return (l >= lanes_.data()) && (l < lanes_.data() + PRIORITY_COUNT);
+        }
+
+        Reactor::Slot* Reactor::pop_ready() noexcept
+        {
+            auto pick = PRIORITY_COUNT;
+            auto starved = PRIORITY_COUNT;
+            bool contended = false;
+
+            for (std::size_t i = 0; i < PRIORITY_COUNT; ++i) {
+                if (quota_[i] == 0) {
+                    continue;
+                }
+
+                if (pick == PRIORITY_COUNT) {
+                    pick = i;
+                    continue;
+                }
+
+                contended = true;
+
+                // Lower lane preempts after too many skips
+                if ((starved == PRIORITY_COUNT)
+                    && (lane_skips_[i] >= lane_burst_)) {
+                    starved = i;
+                }
+            }
+
+            if (pick == PRIORITY_COUNT) {
+                return nullptr;
+            }
+
+            if (starved != PRIORITY_COUNT) {
+                pick = starved;
+            }
+
+            --quota_[pick];
+            auto* s = lanes_[pick].pop_front();
+            lane_skips_[pick] = 0;
+
+            if (contended) {
+                for (std::size_t i = 0; i < PRIORITY_COUNT; ++i) {
+                    if ((i != pick) && (quota_[i] != 0)) {
+                        ++lane_skips_[i];
+                    }
+                }
+            }
+
+            return s;
+        }
+
+        void Reactor::reserve_slots(std::size_t count) noexcept
+        {
+            while (free_count_ < count) {
+                auto* c = new (mem_pool_.allocate(sizeof(SlotChunk), 1))
+                        SlotChunk;
+                c->next = chunks_;
+                chunks_ = c;
+
+                for (auto& s : c->slots) {
+                    s.next = free_slots_;
+                    free_slots_ = &s;
+                }
+
+                free_count_ += SLOT_CHUNK;
+            }
+        }
+
+        Reactor::Slot* Reactor::alloc_slot(CallbackPass& cb) noexcept
+        {
+            if (free_slots_ == nullptr) {
+                reserve_slots(1);
+            }
+
+            auto* s = free_slots_;
+            free_slots_ = s->next;
+            s->next = nullptr;
+            --free_count_;
+
+            cb.move(s->callback, s->storage);
+            s->cycle = cycle_;
+            return s;
+        }
+
+        void Reactor::free_slot(Slot* s) noexcept
+        {
+            s->callback = nullptr;
+            s->storage.set_cleanup(&CallbackPass::Storage::default_cleanup);
+            ++(s->generation);
+
+            s->next = free_slots_;
+            free_slots_ = s;
+            ++free_count_;
+        }
+
+        Reactor::Handle Reactor::make_handle(Slot* s) noexcept
+        {
+            return {*s, *this, s->generation};
+        }
+
+        Reactor::Slot* Reactor::handle_slot(Handle& h) noexcept
+        {
+            HandleAccessor acc(h);
+            auto* internal = acc.internal();
+
+            if ((internal == nullptr) || (acc.async_tool() != this)) {
+                return nullptr;
+            }
+
+            auto* s = static_cast<Slot*>(internal);
+
+            if (s->generation != acc.cookie()) {
+                return nullptr;
+            }
+
+            return s;
+        }
+
+        //---
+        Reactor::Handle Reactor::post(
+                CallbackPass& cb,
+                std::chrono::milliseconds delay,
+                bool deferred,
+                Priority prio) noexcept
+        {
+            auto& pool = GlobalMemPool::get_default().mem_pool(
+                    sizeof(InboxNode), true);
+            auto* n = new (pool.allocate(sizeof(InboxNode), 1)) InboxNode(pool);
+
+            cb.move(n->callback, n->storage);
+            n->deferred = deferred;
+            n->prio = prio;
+
+            if (deferred) {
+                n->when = now() + delay;
+                n->delay = delay;
+            }
+
+            inbox_push(n);
+
+            if (waiting_.exchange(false)) {
+                wakeup();
+            }
+
+            return {};
+        }
+
+        void Reactor::inbox_push(InboxLink* n) noexcept
+        {
+            n->next.store(nullptr, std::memory_order_relaxed);
+            auto* prev = inbox_head_.exchange(n, std::memory_order_acq_rel);
+            prev->next.store(n, std::memory_order_release);
+        }
+
+        Reactor::InboxNode* Reactor::inbox_pop() noexcept
+        {
+            auto* tail = inbox_tail_;
+            auto* next = tail->next.load(std::memory_order_acquire);
+
+            if (tail == &inbox_stub_) {
+                if (next == nullptr) {
+                    return nullptr;
+                }
+
+                inbox_tail_ = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+
+            if (next != nullptr) {
+                inbox_tail_ = next;
+                return static_cast<InboxNode*>(tail);
+            }
+
+            // Producer is in the middle of push
+            if (tail != inbox_head_.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+
+            inbox_push(&inbox_stub_);
+            next = tail->next.load(std::memory_order_acquire);
+
+            if (next != nullptr) {
+                inbox_tail_ = next;
+                return static_cast<InboxNode*>(tail);
+            }
+
+            return nullptr;
+        }
+
+        bool Reactor::arm_waiting() noexcept
+        {
+            // RMW orders against producer exchange() after its push
+            waiting_.exchange(true);
+            return inbox_empty();
+        }
+
+        bool Reactor::inbox_empty() const noexcept
+        {
+            return (inbox_tail_ == &inbox_stub_)
+                   && (inbox_stub_.next.load(std::memory_order_acquire)
+                       == nullptr);
+        }
+
+        void Reactor::drain_inbox() noexcept
+        {
+            while (auto* n = inbox_pop()) {
+                InboxCall call(this, n);
+                CallbackPass cb(std::move(call));
+                auto* s = alloc_slot(cb);
+
+                if (n->deferred) {
+                    s->expire = expire_tick(n->when, n->delay);
+                    insert_timer(s);
+                } else {
+                    lane(n->prio).push_back(s);
+                }
+            }
+        }
+
+        void Reactor::free_node(InboxNode* n) noexcept
+        {
+            auto& pool = n->mem_pool;
+            n->~InboxNode();
+            pool.deallocate(n, sizeof(InboxNode), 1);
+        }
+
+        //---
+        Reactor::Tick Reactor::now_tick() const noexcept
+        {
+            return static_cast<Tick>(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                            now() - start_)
+                            .count());
+        }
+
+        Reactor::Tick Reactor::expire_tick(
+                Clock::time_point when,
+                std::chrono::milliseconds delay) const noexcept
+        {
+            using std::chrono::milliseconds;
+
+            // Round up to never fire early
+            auto target = when - start_;
+            auto expire = std::chrono::duration_cast<milliseconds>(target);
+
+            if (expire < target) {
+                expire += milliseconds(1);
+            }
+
+            Tick res = (expire.count() > 0) ? static_cast<Tick>(expire.count())
+                                            : 0;
+
+            // Coalesce into a shared bucket, slack never exceeds the delay
+            if ((timer_slack_ > 1)
+                && (static_cast<Tick>(delay.count()) >= timer_slack_)) {
+                res = ((res + timer_slack_ - 1) / timer_slack_) * timer_slack_;
+            }
+
+            return res;
+        }
+
+        void Reactor::insert_timer(Slot* s) noexcept
+        {
+            // Current tick is already processed
+            if (s->expire <= current_tick_) {
+                s->expire = current_tick_ + 1;
+            }
+
+            place_timer(s);
+            ++timer_count_;
+        }
+
+        void Reactor::place_timer(Slot* s) noexcept
+        {
+            auto delta = s->expire - current_tick_;
+            auto at = s->expire;
+            std::size_t level = 0;
+
+            // Beyond the wheel span, it's placed again on cascade
+            if (delta > MAX_DELTA) {
+                delta = MAX_DELTA;
+                at = current_tick_ + MAX_DELTA;
+            }
+
+            while ((level + 1 < WHEEL_LEVELS)
+                   && (delta >= (Tick(1) << (WHEEL_BITS * (level + 1))))) {
+                ++level;
+            }
+
+            auto idx = static_cast<std::size_t>(
+                    (at >> (WHEEL_BITS * level)) & WHEEL_MASK);
+            auto& l = wheel_[level];
+
+            l.buckets[idx].push_back(s);
+            set_used(l, idx);
+            s->level = static_cast<std::uint16_t>(level);
+            s->bucket = static_cast<std::uint16_t>(idx);
+        }
+
+        void Reactor::remove_timer(Slot* s) noexcept
+        {
+            auto& l = wheel_[s->level];
+            auto& b = l.buckets[s->bucket];
+
+            b.remove(s);
+
+            if (b.head == nullptr) {
+                clear_used(l, s->bucket);
+            }
+
+            --timer_count_;
+        }
+
+        void Reactor::advance(Tick now) noexcept
+        {
+            while (current_tick_ < now) {
+                if (timer_count_ == 0) {
+                    current_tick_ = now;
+                    break;
+                }
+
+                Tick t = current_tick_ + 1;
+
+                if ((t & WHEEL_MASK) != 0) {
+                    // Skip empty buckets till the end of rotation
+                    auto idx = find_used(
+                            wheel_[0],
+                            static_cast<std::size_t>(t & WHEEL_MASK));
+                    auto next = (t & ~WHEEL_MASK) + idx;
+
+                    if (next > now) {
+                        current_tick_ = now;
+                        break;
+                    }
+
+                    t = next;
+                }
+
+                current_tick_ = t;
+
+                if ((t & WHEEL_MASK) == 0) {
+                    for (std::size_t level = 1; level < WHEEL_LEVELS; ++level) {
+                        cascade(level);
+
+                        if (((t >> (WHEEL_BITS * level)) & WHEEL_MASK) != 0) {
+                            break;
+                        }
+                    }
+                }
+
+                expire_bucket();
+            }
+        }
+
+        void Reactor::cascade(std::size_t level) noexcept
+        {
+            auto& l = wheel_[level];
+            auto idx = static_cast<std::size_t>(
+                    (current_tick_ >> (WHEEL_BITS * level)) & WHEEL_MASK);
+            auto& b = l.buckets[idx];
+
+            clear_used(l, idx);
+
+            while (auto* s = b.pop_front()) {
+                place_timer(s);
+            }
+        }
+
+        void Reactor::expire_bucket() noexcept
+        {
+            auto& l = wheel_[0];
+            auto idx = static_cast<std::size_t>(current_tick_ & WHEEL_MASK);
+            auto& b = l.buckets[idx];
+
+            clear_used(l, idx);
+
+            auto& ready = lane(Priority::Normal);
+
+            while (auto* s = b.pop_front()) {
+                ready.push_back(s);
+                --timer_count_;
+            }
+        }
+
+        Reactor::Tick Reactor::next_wakeup() const noexcept
+        {
+            auto res = ~Tick(0);
+
+            for (std::size_t level = 0; level < WHEEL_LEVELS; ++level) {
+                auto& l = wheel_[level];
+                auto shift = WHEEL_BITS * level;
+                auto base = current_tick_ >> shift;
+                auto cur = static_cast<std::size_t>(base & WHEEL_MASK);
+                auto idx = (cur + 1 < WHEEL_SIZE) ? find_used(l, cur + 1)
+                                                  : WHEEL_SIZE;
+                Tick distance;
+
+                if (idx != WHEEL_SIZE) {
+                    distance = idx - cur;
+                } else {
+                    idx = find_used(l, 0);
+
+                    if ((idx == WHEEL_SIZE) || (idx > cur)) {
+                        continue;
+                    }
+
+                    distance = idx + WHEEL_SIZE - cur;
+                }
+
+                if (level == 0) {
+                    res = std::min(res, base + distance);
+                    continue;
+                }
+
+                // Buckets are ordered in time, so the level earliest expiry
+                // is in the first used one. Cascade tick is not a deadline.
+                for (auto* s = l.buckets[idx].head; s != nullptr; s = s->next) {
+                    res = std::min(res, s->expire);
+                }
+            }
+
+            return res;
+        }
+    } // namespace ri
+} // namespace futoin
@@ -0,0 +1,335 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <futoin/fatalmsg.hpp>
+#include <futoin/ri/reactor.hpp>
+#include <futoin/ri/reactorpool.hpp>
+
+#include <unordered_map>
+
+namespace futoin {
+    namespace ri {
+        struct ReactorPool::Worker
+        {
+            using Roots = std::unordered_map<
+                    IAsyncSteps*,
+                    std::unique_ptr<IAsyncSteps>>;
+
+            Worker(ReactorPool& pool, std::size_t index) noexcept :
+                pool(pool), index(index)
+            {}
+
+            ReactorPool& pool;
+            const std::size_t index;
+            std::thread thread;
+
+            std::mutex mutex;
+            std::deque<Job> jobs;
+            Reactor* reactor{nullptr};
+            std::atomic<bool> idle{false};
+
+            // Owner thread only
+            std::unique_ptr<IAsyncSteps> prototype;
+            Roots roots;
+        };
+
+        /**
+         * @private
+         * Kept in root stack(), so it goes on success, error or cancel
+         */
+        struct ReactorPool::RootRelease
+        {
+            RootRelease(Worker* w, IAsyncSteps* root) noexcept :
+                w(w), root(root)
+            {}
+
+            RootRelease(const RootRelease&) = delete;
+            RootRelease& operator=(const RootRelease&) = delete;
+
+            ~RootRelease() noexcept
+            {
+                // Not from own execution
+                auto* w = this->w;
+                auto* root = this->root;
+                w->reactor->immediate([w, root]() { w->roots.erase(root); });
+            }
+
+            Worker* w;
+            IAsyncSteps* root;
+        };
+
+        struct ReactorPool::StepsJob
+        {
+            ReactorPool* pool;
+            StepsSetup setup;
+
+            void operator()(IAsyncTool& /*tool*/)
+            {
+                pool->start_steps(setup);
+            }
+        };
+
+        thread_local ReactorPool::Worker* ReactorPool::current_worker_ =
+                nullptr;
+
+        //---
+        ReactorPool::ReactorPool(
+                std::size_t threads, StepsFactory steps_factory) noexcept :
+            steps_factory_(std::move(steps_factory))
+        {
+            if (threads == 0) {
+                threads = std::thread::hardware_concurrency();
+
+                if (threads == 0) {
+                    threads = 1;
+                }
+            }
+
+            workers_.reserve(threads);
+
+            for (std::size_t i = 0; i < threads; ++i) {
+                workers_.emplace_back(new Worker(*this, i));
+            }
+
+            for (auto& w : workers_) {
+                auto* pw = w.get();
+                w->thread = std::thread([this, pw]() { run(*pw); });
+            }
+
+            // Reactors are constructed in own threads
+            std::unique_lock<std::mutex> lock(ready_mutex_);
+            ready_cv_.wait(
+                    lock, [this]() { return ready_ == workers_.size(); });
+        }
+
+        ReactorPool::~ReactorPool() noexcept
+        {
+            stop();
+        }
+
+        //---
+        void ReactorPool::submit(Job&& job) noexcept
+        {
+            auto* w = current_worker_;
+
+            if ((w != nullptr) && (&(w->pool) == this)) {
+                submit_to(w->index, std::move(job));
+            } else {
+                submit_to(
+                        next_worker_.fetch_add(1, std::memory_order_relaxed),
+                        std::move(job));
+            }
+        }
+
+        void ReactorPool::submit_to(std::size_t worker, Job&& job) noexcept
+        {
+            auto& w = *workers_[worker % workers_.size()];
+            bool busy;
+
+            {
+                std::lock_guard<std::mutex> lock(w.mutex);
+
+                // Dropped by the caller, nobody would pick it up
+                if (stop_) {
+                    return;
+                }
+
+                pending_.fetch_add(1);
+                w.jobs.push_back(std::move(job));
+                busy = !w.idle.load();
+
+                if ((w.reactor != nullptr) && !busy) {
+                    w.reactor->wakeup();
+                }
+            }
+
+            // Let somebody steal it
+            if (busy) {
+                wake_idle(w.index);
+            }
+        }
+
+        void ReactorPool::wake_idle(std::size_t skip) noexcept
+        {
+            for (auto& w : workers_) {
+                if ((w->index == skip) || !w->idle.load()) {
+                    continue;
+                }
+
+                std::lock_guard<std::mutex> lock(w->mutex);
+
+                if (w->reactor != nullptr) {
+                    w->reactor->wakeup();
+                    break;
+                }
+            }
+        }
+
+        void ReactorPool::submit_steps(StepsSetup&& setup) noexcept
+        {
+            if (!steps_factory_) {
+                FatalMsg() << "ReactorPool::submit_steps() with no factory!";
+            }
+
+            submit(StepsJob{this, std::move(setup)});
+        }
+
+        void ReactorPool::stop() noexcept
+        {
+            stop_ = true;
+
+            for (auto& w : workers_) {
+                std::lock_guard<std::mutex> lock(w->mutex);
+
+                if (w->reactor != nullptr) {
+                    w->reactor->wakeup();
+                }
+            }
+
+            for (auto& w : workers_) {
+                if (w->thread.joinable()) {
+                    w->thread.join();
+                }
+            }
+        }
+
+        //---
+        void ReactorPool::run(Worker& w) noexcept
+        {
+            Reactor reactor;
+            current_worker_ = &w;
+
+            {
+                std::lock_guard<std::mutex> lock(w.mutex);
+                w.reactor = &reactor;
+            }
+
+            if (steps_factory_) {
+                w.prototype = steps_factory_(reactor);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(ready_mutex_);
+                ++ready_;
+            }
+
+            ready_cv_.notify_all();
+
+            Job job;
+
+            while (!stop_) {
+                auto res = reactor.iterate();
+                bool busy = res.have_work && (res.delay.count() == 0);
+
+                if (pop_local(w, job) || (!busy && steal(w, job))) {
+                    // Spread the rest while busy with this one
+                    if (pending_.load() > 0) {
+                        wake_idle(w.index);
+                    }
+
+                    job(reactor);
+                    job = nullptr;
+                    continue;
+                }
+
+                if (busy) {
+                    continue;
+                }
+
+                // Submitters check the flag under worker mutex
+                w.idle = true;
+
+                if (!stop_ && (pending_.load() == 0)) {
+                    reactor.wait(
+                            res.have_work ? res.delay
+                                          : std::chrono::milliseconds(-1));
+                }
+
+                w.idle = false;
+            }
+
+            // Roots must go before their reactor
+            w.roots.clear();
+
+            std::deque<Job> dropped;
+
+            {
+                std::lock_guard<std::mutex> lock(w.mutex);
+                dropped.swap(w.jobs);
+            }
+
+            dropped.clear();
+            w.prototype.reset();
+
+            {
+                std::lock_guard<std::mutex> lock(w.mutex);
+                w.reactor = nullptr;
+            }
+
+            current_worker_ = nullptr;
+        }
+
+        bool ReactorPool::pop_local(Worker& w, Job& job) noexcept
+        {
+            std::lock_guard<std::mutex> lock(w.mutex);
+
+            if (w.jobs.empty()) {
+                return false;
+            }
+
+            job = std::move(w.jobs.front());
+            w.jobs.pop_front();
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool ReactorPool::steal(Worker& w, Job& job) noexcept
+        {
+            const auto count = workers_.size();
+
+            for (std::size_t i = 1; i < count; ++i) {
+                auto& victim = *workers_[(w.index + i) % count];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+
+                if (!victim.jobs.empty()) {
+                    job = std::move(victim.jobs.back());
+                    victim.jobs.pop_back();
+                    pending_.fetch_sub(1, std::memory_order_relaxed);
+                    steals_.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        //---
+        void ReactorPool::start_steps(StepsSetup& setup) noexcept
+        {
+            auto* w = current_worker_;
+            auto asi = w->prototype->newInstance();
+            auto* root = asi.get();
+            w->roots.emplace(root, std::move(asi));
+
+            // Errors are dropped, unless setup installs own handler
+            root->state().set_unhandled_error([](ErrorCode /*code*/) {});
+            root->stack<RootRelease>(w, root);
+            setup(*root);
+            root->execute();
+        }
+    } // namespace ri
+} // namespace futoin
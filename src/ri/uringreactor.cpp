@@ -0,0 +1,702 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <futoin/ri/uringreactor.hpp>
+
+#ifdef FUTOIN_RI_URING
+
+#    include <cerrno>
+#    include <cstring>
+#    include <ctime>
+#    include <limits>
+#    include <new>
+
+#    include <linux/io_uring.h>
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+
+namespace futoin {
+    namespace ri {
+        namespace {
+            // Op pointers are even, tags are odd
+            constexpr std::uint64_t WAKEUP_TAG = 1;
+            constexpr std::uint64_t TIMEOUT_TAG = 3;
+            constexpr unsigned TIMEOUT_SEQ_SHIFT = 2;
+
+            inline bool is_timeout_tag(std::uint64_t user_data) noexcept
+            {
+                return (user_data & TIMEOUT_TAG) == TIMEOUT_TAG;
+            }
+
+            static_assert(
+                    sizeof(__kernel_timespec) == sizeof(std::int64_t) * 2,
+                    "Unexpected __kernel_timespec layout");
+
+            inline unsigned load_acquire(const unsigned* p) noexcept
+            {
+                return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+            }
+
+            inline void store_release(unsigned* p, unsigned v) noexcept
+            {
+                __atomic_store_n(p, v, __ATOMIC_RELEASE);
+            }
+
+            inline std::int64_t monotonic_ns() noexcept
+            {
+                timespec ts{};
+                ::clock_gettime(CLOCK_MONOTONIC, &ts);
+                return std::int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+            }
+
+            template<typename T>
+            inline T* at(void* base, std::size_t offset) noexcept
+            {
+                return reinterpret_cast<T*>(
+                        reinterpret_cast<char*>(base) + offset);
+            }
+        } // namespace
+
+        struct UringReactor::Op
+        {
+            Op* prev{nullptr};
+            Op* next{nullptr};
+            IoCallback callback;
+            IoPass::Storage storage;
+            // Owned buffer of IAsyncSteps I/O
+            void* bounce{nullptr};
+            std::size_t bounce_size{0};
+            void* out{nullptr};
+            bool queued{false};
+            bool canceled{false};
+            bool done{false};
+        };
+
+        //---
+        UringReactor::UringReactor(
+                IMemPool& mem_pool, unsigned entries) noexcept :
+            Reactor(mem_pool)
+        {
+            io_uring_params p;
+            std::memset(&p, 0, sizeof(p));
+
+            auto fd = static_cast<int>(
+                    ::syscall(__NR_io_uring_setup, entries, &p));
+
+            if (fd < 0) {
+                return;
+            }
+
+            const bool single_mmap = (p.features & IORING_FEAT_SINGLE_MMAP);
+
+            sq_map_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+            cq_map_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+
+            if (single_mmap && (cq_map_size_ > sq_map_size_)) {
+                sq_map_size_ = cq_map_size_;
+            }
+
+            sq_map_ = ::mmap(
+                    nullptr,
+                    sq_map_size_,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    fd,
+                    IORING_OFF_SQ_RING);
+
+            if (sq_map_ == MAP_FAILED) {
+                sq_map_ = nullptr;
+                ::close(fd);
+                return;
+            }
+
+            if (single_mmap) {
+                cq_map_ = sq_map_;
+                cq_map_size_ = 0;
+            } else {
+                cq_map_ = ::mmap(
+                        nullptr,
+                        cq_map_size_,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE,
+                        fd,
+                        IORING_OFF_CQ_RING);
+
+                if (cq_map_ == MAP_FAILED) {
+                    cq_map_ = nullptr;
+                    ::munmap(sq_map_, sq_map_size_);
+                    sq_map_ = nullptr;
+                    ::close(fd);
+                    return;
+                }
+            }
+
+            sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+            sqes_ = ::mmap(
+                    nullptr,
+                    sqes_size_,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    fd,
+                    IORING_OFF_SQES);
+
+            if (sqes_ == MAP_FAILED) {
+                sqes_ = nullptr;
+
+                if (cq_map_size_ != 0) {
+                    ::munmap(cq_map_, cq_map_size_);
+                }
+
+                cq_map_ = nullptr;
+                ::munmap(sq_map_, sq_map_size_);
+                sq_map_ = nullptr;
+                ::close(fd);
+                return;
+            }
+
+            sq_head_ = at<unsigned>(sq_map_, p.sq_off.head);
+            sq_tail_ = at<unsigned>(sq_map_, p.sq_off.tail);
+            sq_mask_ = at<unsigned>(sq_map_, p.sq_off.ring_mask);
+            sq_array_ = at<unsigned>(sq_map_, p.sq_off.array);
+            cq_head_ = at<unsigned>(cq_map_, p.cq_off.head);
+            cq_tail_ = at<unsigned>(cq_map_, p.cq_off.tail);
+            cq_mask_ = at<unsigned>(cq_map_, p.cq_off.ring_mask);
+            cqes_ = at<void>(cq_map_, p.cq_off.cqes);
+
+            ring_fd_ = fd;
+        }
+
+        UringReactor::~UringReactor() noexcept
+        {
+            if (ring_fd_ >= 0) {
+                // Kernel may still use the buffers after close()
+                closing_ = true;
+                bool wakeup_canceled = false;
+
+                for (;;) {
+                    bool pending = false;
+
+                    for (auto* op = ops_; op != nullptr; op = op->next) {
+                        if (op->queued) {
+                            pending = true;
+
+                            if (!op->canceled) {
+                                op->canceled = cancel_io(
+                                        reinterpret_cast<std::uintptr_t>(op));
+                            }
+                        }
+                    }
+
+                    if (wakeup_armed_) {
+                        pending = true;
+
+                        if (!wakeup_canceled) {
+                            wakeup_canceled = cancel_io(WAKEUP_TAG);
+                        }
+                    }
+
+                    if (!pending) {
+                        break;
+                    }
+
+                    if ((enter(1) < 0) && (errno != EINTR)) {
+                        break;
+                    }
+
+                    reap();
+                }
+
+                ::close(ring_fd_);
+                ::munmap(sqes_, sqes_size_);
+
+                if (cq_map_size_ != 0) {
+                    ::munmap(cq_map_, cq_map_size_);
+                }
+
+                ::munmap(sq_map_, sq_map_size_);
+            }
+
+            while (ops_ != nullptr) {
+                free_op(ops_);
+            }
+        }
+
+        //---
+        UringReactor::CycleResult UringReactor::iterate(
+                const CycleBudget& budget, CycleStats* stats) noexcept
+        {
+            if (ring_fd_ >= 0) {
+                if (to_submit_ != 0) {
+                    enter(0);
+                }
+
+                reap();
+            }
+
+            auto res = Reactor::iterate(budget, stats);
+
+            // Let wakeup_fd() report cross-thread posts
+            if (ring_fd_ >= 0) {
+                arm_wakeup();
+
+                if (to_submit_ != 0) {
+                    enter(0);
+                }
+            }
+
+            if (!res.have_work && (io_count_ != 0)) {
+                return {true,
+                        std::chrono::milliseconds(
+                                std::numeric_limits<int>::max())};
+            }
+
+            return res;
+        }
+
+        int UringReactor::wakeup_fd() noexcept
+        {
+            return (ring_fd_ >= 0) ? ring_fd_ : Reactor::wakeup_fd();
+        }
+
+        void UringReactor::drain_wakeup() noexcept
+        {
+            // Armed IORING_OP_READ consumes it otherwise
+            if (ring_fd_ < 0) {
+                Reactor::drain_wakeup();
+            }
+        }
+
+        void UringReactor::sleep(std::chrono::milliseconds timeout) noexcept
+        {
+            if (ring_fd_ < 0) {
+                Reactor::sleep(timeout);
+                return;
+            }
+
+            // Completions are already there
+            if (*cq_head_ != load_acquire(cq_tail_)) {
+                if (to_submit_ != 0) {
+                    enter(0);
+                }
+
+                return;
+            }
+
+            arm_wakeup();
+
+            if (timeout.count() == 0) {
+                enter(0);
+                return;
+            }
+
+            if (timeout.count() > 0) {
+                arm_timeout(timeout);
+            }
+
+            enter(1);
+        }
+
+        //---
+        void UringReactor::read(
+                int fd,
+                void* buf,
+                std::size_t len,
+                std::uint64_t offset,
+                IoPass&& cb) noexcept
+        {
+            queue_op(alloc_op(cb), IORING_OP_READ, fd, buf, len, offset);
+        }
+
+        void UringReactor::write(
+                int fd,
+                const void* buf,
+                std::size_t len,
+                std::uint64_t offset,
+                IoPass&& cb) noexcept
+        {
+            queue_op(alloc_op(cb), IORING_OP_WRITE, fd, buf, len, offset);
+        }
+
+        void UringReactor::accept(int fd, IoPass&& cb) noexcept
+        {
+            queue_op(alloc_op(cb), IORING_OP_ACCEPT, fd, nullptr, 0, 0);
+        }
+
+        void UringReactor::read(
+                IAsyncSteps& asi,
+                int fd,
+                void* buf,
+                std::size_t len,
+                std::uint64_t offset) noexcept
+        {
+            steps_op(asi, IORING_OP_READ, fd, buf, len, offset);
+        }
+
+        void UringReactor::write(
+                IAsyncSteps& asi,
+                int fd,
+                const void* buf,
+                std::size_t len,
+                std::uint64_t offset) noexcept
+        {
+            steps_op(asi, IORING_OP_WRITE, fd, buf, len, offset);
+        }
+
+        void UringReactor::accept(IAsyncSteps& asi, int fd) noexcept
+        {
+            steps_op(asi, IORING_OP_ACCEPT, fd, nullptr, 0, 0);
+        }
+
+        //---
+        UringReactor::Op* UringReactor::alloc_op(IoPass& cb) noexcept
+        {
+            auto& pool = mem_pool(sizeof(Op), true);
+            auto* op = new (pool.allocate(sizeof(Op), 1)) Op;
+
+            cb.move(op->callback, op->storage);
+
+            op->next = ops_;
+
+            if (ops_ != nullptr) {
+                ops_->prev = op;
+            }
+
+            ops_ = op;
+            ++io_count_;
+            return op;
+        }
+
+        void UringReactor::free_op(Op* op) noexcept
+        {
+            if (op->prev != nullptr) {
+                op->prev->next = op->next;
+            } else {
+                ops_ = op->next;
+            }
+
+            if (op->next != nullptr) {
+                op->next->prev = op->prev;
+            }
+
+            --io_count_;
+
+            if (op->bounce != nullptr) {
+                mem_pool().deallocate(op->bounce, 1, op->bounce_size);
+            }
+
+            op->~Op();
+            mem_pool(sizeof(Op), true).deallocate(op, sizeof(Op), 1);
+        }
+
+        void* UringReactor::get_sqe() noexcept
+        {
+            if (ring_fd_ < 0) {
+                return nullptr;
+            }
+
+            const auto entries = *sq_mask_ + 1;
+            auto tail = *sq_tail_;
+
+            if ((tail - load_acquire(sq_head_)) >= entries) {
+                enter(0);
+
+                if ((tail - load_acquire(sq_head_)) >= entries) {
+                    return nullptr;
+                }
+            }
+
+            auto idx = tail & *sq_mask_;
+            auto* sqe = static_cast<io_uring_sqe*>(sqes_) + idx;
+            std::memset(sqe, 0, sizeof(*sqe));
+
+            // Kernel reads entries only in io_uring_enter() of this thread
+            sq_array_[idx] = idx;
+            store_release(sq_tail_, tail + 1);
+            ++to_submit_;
+
+            return sqe;
+        }
+
+        void UringReactor::queue_op(
+                Op* op,
+                std::uint8_t opcode,
+                int fd,
+                const void* addr,
+                std::size_t len,
+                std::uint64_t offset) noexcept
+        {
+            auto* sqe = closing_ ? nullptr
+                                 : static_cast<io_uring_sqe*>(get_sqe());
+
+            if (sqe == nullptr) {
+                // Still complete asynchronously
+                auto* self = this;
+                immediate([self, op]() {
+                    auto err = (self->ring_fd_ < 0) ? -ENOSYS : -EBUSY;
+                    op->done = true;
+
+                    if (op->callback) {
+                        op->callback(err);
+                    }
+
+                    self->free_op(op);
+                });
+                return;
+            }
+
+            sqe->opcode = opcode;
+            sqe->fd = fd;
+            sqe->addr = reinterpret_cast<std::uintptr_t>(addr);
+            // Result is int, so it's at most 2 GiB like for read(2)
+            sqe->len = static_cast<std::uint32_t>(
+                    (len < MAX_IO_SIZE) ? len : MAX_IO_SIZE);
+            sqe->off = offset;
+            sqe->user_data = reinterpret_cast<std::uintptr_t>(op);
+            op->queued = true;
+        }
+
+        void UringReactor::steps_op(
+                IAsyncSteps& asi,
+                std::uint8_t opcode,
+                int fd,
+                const void* addr,
+                std::size_t len,
+                std::uint64_t offset) noexcept
+        {
+            auto* pasi = &asi;
+            const bool is_accept = (opcode == IORING_OP_ACCEPT);
+
+            asi.waitExternal();
+
+            // IoPass refers to it till alloc_op() moves it
+            auto on_done = [pasi, is_accept](int res) {
+                if (res < 0) {
+                    pasi->errorNoThrow(
+                            errors::CommError,
+                            ErrorMessage(std::strerror(-res)));
+                } else if (is_accept) {
+                    pasi->success(static_cast<int>(res));
+                } else {
+                    pasi->success(static_cast<std::size_t>(res));
+                }
+            };
+            IoPass cb(std::move(on_done));
+            auto* op = alloc_op(cb);
+            auto* self = this;
+
+            // Kernel may use the buffer till completion even after cancel,
+            // but the step may release it, e.g. with stack().
+            if (len != 0) {
+                len = (len < MAX_IO_SIZE) ? len : MAX_IO_SIZE;
+                op->bounce = mem_pool().allocate(1, len);
+                op->bounce_size = len;
+
+                if (opcode == IORING_OP_READ) {
+                    op->out = const_cast<void*>(addr);
+                } else {
+                    std::memcpy(op->bounce, addr, len);
+                }
+
+                addr = op->bounce;
+            }
+
+            queue_op(op, opcode, fd, addr, len, offset);
+
+            asi.setCancel([self, op](IAsyncSteps&) {
+                // Error raised by own completion
+                if (op->done) {
+                    return;
+                }
+
+                // Result is dropped, op is freed on its completion
+                op->callback = nullptr;
+                op->canceled =
+                        self->cancel_io(reinterpret_cast<std::uintptr_t>(op));
+            });
+        }
+
+        bool UringReactor::cancel_io(std::uint64_t user_data) noexcept
+        {
+            auto* sqe = static_cast<io_uring_sqe*>(get_sqe());
+
+            if (sqe == nullptr) {
+                return false;
+            }
+
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->addr = user_data;
+            sqe->user_data = 0;
+            return true;
+        }
+
+        void UringReactor::arm_wakeup() noexcept
+        {
+            if (wakeup_armed_ || (event_fd() < 0)) {
+                return;
+            }
+
+            auto* sqe = static_cast<io_uring_sqe*>(get_sqe());
+
+            if (sqe != nullptr) {
+                sqe->opcode = IORING_OP_READ;
+                sqe->fd = event_fd();
+                sqe->addr = reinterpret_cast<std::uintptr_t>(&wakeup_buf_);
+                sqe->len = sizeof(wakeup_buf_);
+                sqe->off = ~std::uint64_t(0);
+                sqe->user_data = WAKEUP_TAG;
+                wakeup_armed_ = true;
+            }
+        }
+
+        void UringReactor::arm_timeout(
+                std::chrono::milliseconds timeout) noexcept
+        {
+            const auto max_ms =
+                    std::numeric_limits<std::int64_t>::max() / 2000000;
+            auto ms = (timeout.count() < max_ms) ? timeout.count() : max_ms;
+            auto deadline = monotonic_ns() + ms * 1000000;
+
+            if (timeout_armed_ != 0) {
+                // Already armed one fires earlier
+                if (timeout_deadline_ <= deadline) {
+                    return;
+                }
+
+                // Superseded one completes with -ECANCELED
+                auto* sqe = static_cast<io_uring_sqe*>(get_sqe());
+
+                if (sqe == nullptr) {
+                    return;
+                }
+
+                sqe->opcode = IORING_OP_TIMEOUT_REMOVE;
+                sqe->fd = -1;
+                sqe->addr = timeout_armed_;
+                sqe->user_data = 0;
+                timeout_armed_ = 0;
+            }
+
+            auto* sqe = static_cast<io_uring_sqe*>(get_sqe());
+
+            if (sqe == nullptr) {
+                return;
+            }
+
+            // Kernel copies the spec on submission by enter() of sleep(),
+            // so there is a single one queued at a time.
+            timeout_spec_[0] = deadline / 1000000000;
+            timeout_spec_[1] = deadline % 1000000000;
+
+            ++timeout_seq_;
+            timeout_armed_ = (timeout_seq_ << TIMEOUT_SEQ_SHIFT) | TIMEOUT_TAG;
+            timeout_deadline_ = deadline;
+
+            sqe->opcode = IORING_OP_TIMEOUT;
+            sqe->fd = -1;
+            sqe->addr = reinterpret_cast<std::uintptr_t>(
+                    timeout_spec_.data());
+            sqe->len = 1;
+            sqe->off = 0;
+            sqe->timeout_flags = IORING_TIMEOUT_ABS;
+            sqe->user_data = timeout_armed_;
+        }
+
+        int UringReactor::enter(unsigned min_complete) noexcept
+        {
+            const unsigned flags = (min_complete != 0) ? IORING_ENTER_GETEVENTS
+                                                       : 0;
+            auto res = static_cast<int>(::syscall(
+                    __NR_io_uring_enter,
+                    ring_fd_,
+                    to_submit_,
+                    min_complete,
+                    flags,
+                    nullptr,
+                    0));
+
+            if (res > 0) {
+                to_submit_ -= (static_cast<unsigned>(res) < to_submit_)
+                                      ? static_cast<unsigned>(res)
+                                      : to_submit_;
+            }
+
+            return res;
+        }
+
+        bool UringReactor::reap() noexcept
+        {
+            auto head = *cq_head_;
+            const auto* cqes = static_cast<const io_uring_cqe*>(cqes_);
+            bool any = false;
+
+            for (;;) {
+                if (head == load_acquire(cq_tail_)) {
+                    break;
+                }
+
+                const auto& cqe = cqes[head & *cq_mask_];
+                auto user_data = cqe.user_data;
+                auto res = cqe.res;
+
+                // Release the entry before callbacks may submit more
+                ++head;
+                store_release(cq_head_, head);
+                any = true;
+
+                if (user_data == 0) {
+                    continue;
+                }
+
+                if (user_data == WAKEUP_TAG) {
+                    wakeup_armed_ = false;
+                    continue;
+                }
+
+                if (is_timeout_tag(user_data)) {
+                    // Removed ones are not tracked anymore
+                    if (user_data == timeout_armed_) {
+                        timeout_armed_ = 0;
+                    }
+
+                    continue;
+                }
+
+                auto* op = reinterpret_cast<Op*>(user_data);
+                op->done = true;
+
+                if (op->callback) {
+                    if ((op->out != nullptr) && (res > 0)) {
+                        std::memcpy(
+                                op->out,
+                                op->bounce,
+                                static_cast<std::size_t>(res));
+                    }
+
+                    op->callback(res);
+                }
+
+                free_op(op);
+            }
+
+            return any;
+        }
+    } // namespace ri
+} // namespace futoin
+
+#endif
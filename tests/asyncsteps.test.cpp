@@ -0,0 +1,1167 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <future>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <futoin/ri/asyncsteps.hpp>
+#include <futoin/ri/reactor.hpp>
+#include <futoin/ri/reactorpool.hpp>
+
+using futoin::ErrorCode;
+using futoin::GlobalMemPool;
+using futoin::IAsyncSteps;
+using futoin::IMemPool;
+using futoin::ISync;
+using futoin::ri::AsyncSteps;
+using futoin::ri::Reactor;
+using futoin::ri::ReactorPool;
+using std::chrono::milliseconds;
+using ParallelMode = futoin::IAsyncSteps::ParallelMode;
+
+namespace {
+    struct CountingMemPool : IMemPool
+    {
+        void* allocate(size_t object_size, size_t count) noexcept override
+        {
+            ++allocs;
+            return parent.allocate(object_size, count);
+        }
+
+        void deallocate(
+                void* ptr, size_t object_size, size_t count) noexcept override
+        {
+            ++deallocs;
+            parent.deallocate(ptr, object_size, count);
+        }
+
+        void release_memory() noexcept override {}
+
+        IMemPool& parent{GlobalMemPool::get_default()};
+        size_t allocs{0};
+        size_t deallocs{0};
+    };
+
+    struct CountingSync : ISync
+    {
+        void lock(IAsyncSteps& asi) noexcept override
+        {
+            ++locks;
+            asi.success();
+        }
+
+        void unlock(IAsyncSteps& /*asi*/) noexcept override
+        {
+            ++unlocks;
+        }
+
+        int locks{0};
+        int unlocks{0};
+    };
+
+    struct CountingReactor : Reactor
+    {
+        Handle immediate_priority(
+                Priority prio, CallbackPass&& cb) noexcept override
+        {
+            ++posts;
+            return Reactor::immediate_priority(prio, std::move(cb));
+        }
+
+        std::size_t posts{0};
+    };
+
+    struct Tracked
+    {
+        explicit Tracked(int& count) noexcept : count(count)
+        {
+            ++count;
+        }
+
+        ~Tracked() noexcept
+        {
+            --count;
+        }
+
+        int& count;
+    };
+
+    std::unique_ptr<IAsyncSteps> steps_factory(futoin::IAsyncTool& tool)
+    {
+        return std::unique_ptr<IAsyncSteps>(new AsyncSteps(tool));
+    }
+
+    void run_till_done(Reactor& reactor, AsyncSteps& root)
+    {
+        while (root.is_running()) {
+            reactor.run();
+            reactor.wait(milliseconds(10));
+        }
+    }
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ri_asyncsteps) // NOLINT
+
+BOOST_AUTO_TEST_CASE(sequence) // NOLINT
+{
+    Reactor reactor;
+    AsyncSteps root(reactor);
+    std::vector<int> order;
+
+    root.add([&](IAsyncSteps& as) {
+        order.push_back(1);
+        as.add([&](IAsyncSteps& as) {
+            order.push_back(2);
+            as.add([&](IAsyncSteps&) { order.push_back(3); });
+        });
+        as.add([&](IAsyncSteps& as) {
+            order.push_back(4);
+            as(5, futoin::string("abc"));
+        });
+    });
+    root.add([&](IAsyncSteps&, int i, futoin::string&& s) {
+        order.push_back(i);
+        BOOST_CHECK_EQUAL(s, "abc");
+    });
+    root.add([&](IAsyncSteps& as) {
+        as.waitExternal();
+        as.tool().immediate([&]() {
+            order.push_back(6);
+            as();
+        });
+    });
+
+    root.execute();
+    BOOST_CHECK(root.is_running());
+    BOOST_CHECK(order.empty());
+
+    reactor.run();
+    BOOST_CHECK(!root.is_running());
+    BOOST_CHECK((order == std::vector<int>{1, 2, 3, 4, 5, 6}));
+
+    // Reuse
+    root.add([&](IAsyncSteps&) { order.push_back(7); });
+    root.execute();
+    reactor.run();
+    BOOST_CHECK_EQUAL(order.back(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(errors) // NOLINT
+{
+    Reactor reactor;
+    AsyncSteps root(reactor);
+    std::vector<futoin::string> log;
+    futoin::string unhandled;
+
+    root.state().set_unhandled_error([&](ErrorCode code) {
+        unhandled = static_cast<const char*>(code);
+    });
+
+    root.add(
+            [&](IAsyncSteps& as) {
+                as.add([&](IAsyncSteps& as) { as.error("First", "info"); },
+                       [&](IAsyncSteps& as, ErrorCode code) {
+                           log.emplace_back(code);
+                           BOOST_CHECK_EQUAL(as.state().error_info(), "info");
+                           as.success(1);
+                       });
+                as.add([&](IAsyncSteps&, int i) {
+                    BOOST_CHECK_EQUAL(i, 1);
+                    throw std::runtime_error("oops");
+                });
+                as.add([&](IAsyncSteps&) { log.emplace_back("unreachable"); });
+            },
+            [&](IAsyncSteps& as, ErrorCode code) {
+                log.emplace_back(code);
+                BOOST_CHECK_EQUAL(as.state().error_info(), "oops");
+                as.add([&](IAsyncSteps& as) { as.error("Second"); });
+            });
+    root.add([&](IAsyncSteps&) { log.emplace_back("unreachable"); });
+
+    root.execute();
+    reactor.run();
+
+    BOOST_CHECK((log
+                 == std::vector<futoin::string>{
+                         "First", futoin::errors::InternalError}));
+    BOOST_CHECK_EQUAL(unhandled, "Second");
+    BOOST_CHECK(!root.is_running());
+}
+
+BOOST_AUTO_TEST_CASE(loops) // NOLINT
+{
+    Reactor reactor;
+    AsyncSteps root(reactor);
+    std::vector<int> order;
+    std::vector<int> values{10, 20, 30};
+    std::map<int, int> pairs{{1, 2}, {3, 4}};
+    int outer = 0;
+
+    root.repeat(5, [&](IAsyncSteps& as, std::size_t i) {
+        if (i == 1) {
+            as.continueLoop();
+        }
+
+        if (i == 3) {
+            as.breakLoop();
+        }
+
+        order.push_back(static_cast<int>(i));
+    });
+    root.forEach(std::ref(values), [&](IAsyncSteps&, std::size_t, int& v) {
+        order.push_back(v);
+    });
+    root.forEach(std::ref(pairs), [&](IAsyncSteps&, const int& k, int& v) {
+        order.push_back(k + v);
+    });
+    root.loop(
+            [&](IAsyncSteps& as) {
+                ++outer;
+                as.loop([&](IAsyncSteps& as) {
+                    as.add([&](IAsyncSteps& as) {
+                        if (outer == 3) {
+                            as.breakLoop("outer");
+                        }
+
+                        as.continueLoop("outer");
+                    });
+                });
+            },
+            "outer");
+
+    root.execute();
+    reactor.run();
+
+    BOOST_CHECK((order == std::vector<int>{0, 2, 10, 20, 30, 3, 7}));
+    BOOST_CHECK_EQUAL(outer, 3);
+    BOOST_CHECK(!root.is_running());
+}
+
+BOOST_AUTO_TEST_CASE(parallel) // NOLINT
+{
+    Reactor reactor;
+    AsyncSteps root(reactor);
+    std::vector<int> order;
+
+    root.add([&](IAsyncSteps& as) {
+        auto& p = as.parallel();
+
+        for (int i = 0; i < 3; ++i) {
+            p.add([&, i](IAsyncSteps& as) {
+                order.push_back(i);
+                as.add([&, i](IAsyncSteps&) { order.push_back(10 + i); });
+            });
+        }
+    });
+    root.add([&](IAsyncSteps&) { order.push_back(100); });
+
+    root.execute();
+    reactor.run();
+
+    // Branches interleave
+    BOOST_CHECK((order == std::vector<int>{0, 1, 2, 10, 11, 12, 100}));
+
+    // Error cancels other branches
+    int canceled = 0;
+    futoin::string handled;
+    order.clear();
+
+    root.add([&](IAsyncSteps& as) {
+        auto& p = as.parallel([&](IAsyncSteps& as, ErrorCode code) {
+            handled = static_cast<const char*>(code);
+            as.success();
+        });
+
+        p.add([&](IAsyncSteps& as) {
+            as.setCancel([&](IAsyncSteps&) { ++canceled; });
+        });
+        p.add([&](IAsyncSteps& as) { as.error("Failed"); });
+        p.add([&](IAsyncSteps&) { order.push_back(1); });
+    });
+    root.add([&](IAsyncSteps&) { order.push_back(100); });
+
+    root.execute();
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(canceled, 1);
+    BOOST_CHECK_EQUAL(handled, "Failed");
+    // Pending branch is dropped
+    BOOST_CHECK((order == std::vector<int>{100}));
+}
+
+BOOST_AUTO_TEST_CASE(parallel_limit) // NOLINT
+{
+    struct Counters
+    {
+        std::atomic<int> active{0};
+        std::atomic<int> max_active{0};
+        std::atomic<int> done{0};
+    } c;
+
+    ReactorPool pool(2, &steps_factory);
+    Reactor reactor;
+    AsyncSteps root(reactor);
+
+    root.set_thread_pool(&pool);
+
+    auto branch = [&c](IAsyncSteps& as) {
+        auto now = ++c.active;
+        auto prev = c.max_active.load();
+
+        while (now > prev && !c.max_active.compare_exchange_weak(prev, now)) {
+        }
+
+        auto& handle = as.stack<futoin::IAsyncTool::Handle>();
+        handle = as.tool().deferred(milliseconds(1), [&c, &as]() {
+            --c.active;
+            ++c.done;
+            as();
+        });
+        as.setCancel([&handle](IAsyncSteps&) { handle.cancel(); });
+    };
+
+    for (auto mode : {ParallelMode::Pseudo, ParallelMode::Threads}) {
+        c.max_active = 0;
+        c.done = 0;
+
+        root.add([&](IAsyncSteps& as) {
+            auto& p = as.parallel({}, 3, mode);
+
+            for (int i = 0; i < 10; ++i) {
+                p.add(branch);
+            }
+        });
+
+        root.execute();
+        run_till_done(reactor, root);
+
+        BOOST_CHECK_EQUAL(c.done.load(), 10);
+        BOOST_CHECK_EQUAL(c.max_active.load(), 3);
+    }
+
+    // Not started branches are dropped on error
+    futoin::string handled;
+    c.done = 0;
+
+    root.add([&](IAsyncSteps& as) {
+        auto& p = as.parallel(
+                [&](IAsyncSteps& as, ErrorCode code) {
+                    handled = static_cast<const char*>(code);
+                    as();
+                },
+                2);
+
+        p.add(branch);
+        p.add([](IAsyncSteps& as) { as.error("Failed"); });
+
+        for (int i = 0; i < 10; ++i) {
+            p.add(branch);
+        }
+    });
+
+    root.execute();
+    run_till_done(reactor, root);
+
+    BOOST_CHECK_EQUAL(handled, "Failed");
+    BOOST_CHECK_EQUAL(c.done.load(), 0);
+    BOOST_CHECK_EQUAL(reactor.deferred_count(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_each) // NOLINT
+{
+    ReactorPool pool(2, &steps_factory);
+    Reactor reactor;
+    AsyncSteps root(reactor);
+    std::vector<int> values(100);
+    std::vector<int> empty;
+    std::atomic<int> sum{0};
+    std::size_t calls = 0;
+
+    root.set_thread_pool(&pool);
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i);
+    }
+
+    root.add([&](IAsyncSteps& as) {
+        as.parallelForEach(
+                std::ref(values),
+                [&](IAsyncSteps& as, std::size_t i, int& v) {
+                    ++calls;
+                    v *= 2;
+
+                    if (i == 99) {
+                        as.add([&](IAsyncSteps&) { ++calls; });
+                    }
+                },
+                3,
+                7);
+        as.parallelForEach(
+                std::ref(empty), [](IAsyncSteps&, std::size_t, int&) {});
+    });
+    root.add([&](IAsyncSteps& as) {
+        as.parallelForEach(
+                std::cref(values),
+                [&](IAsyncSteps&, std::size_t, const int& v) { sum += v; },
+                2,
+                10,
+                ParallelMode::Threads);
+    });
+
+    root.execute();
+    run_till_done(reactor, root);
+
+    BOOST_CHECK_EQUAL(calls, 101U);
+    BOOST_CHECK_EQUAL(values[42], 84);
+    BOOST_CHECK_EQUAL(sum.load(), 9900);
+
+    // Error stops the rest
+    futoin::string handled;
+    calls = 0;
+
+    root.parallelForEach(
+            std::ref(values),
+            [&](IAsyncSteps& as, std::size_t i, int&) {
+                if (i == 5) {
+                    as.error("Failed");
+                }
+
+                ++calls;
+            },
+            1,
+            10,
+            ParallelMode::Pseudo,
+            [&](IAsyncSteps&, ErrorCode code) {
+                handled = static_cast<const char*>(code);
+            });
+    root.state().set_unhandled_error([](ErrorCode) {});
+    root.execute();
+    run_till_done(reactor, root);
+
+    BOOST_CHECK_EQUAL(handled, "Failed");
+    BOOST_CHECK_EQUAL(calls, 5U);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_threads) // NOLINT
+{
+    ReactorPool pool(2, &steps_factory);
+    Reactor reactor;
+    AsyncSteps root(reactor);
+    std::vector<std::thread::id> ids(8);
+    const auto origin = std::this_thread::get_id();
+
+    root.set_thread_pool(&pool);
+    BOOST_CHECK_EQUAL(root.thread_pool(), &pool);
+
+    root.add([&](IAsyncSteps& as) {
+        auto& p = as.parallel({}, ParallelMode::Threads);
+
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            p.add([&, i](IAsyncSteps& as) {
+                as.add([&, i](IAsyncSteps&) {
+                    ids[i] = std::this_thread::get_id();
+                });
+            });
+        }
+
+        // Recovered in the branch
+        p.add([](IAsyncSteps& as) { as.error("Ignored"); },
+              [](IAsyncSteps& as, ErrorCode) { as(); });
+    });
+    root.add([&](IAsyncSteps& as) {
+        BOOST_CHECK(as.tool().is_same_thread());
+
+        for (auto& id : ids) {
+            BOOST_CHECK(id != std::thread::id());
+            BOOST_CHECK(id != origin);
+        }
+    });
+
+    root.execute();
+    run_till_done(reactor, root);
+
+    // Error is joined back
+    futoin::string handled;
+    futoin::string info;
+
+    root.add([&](IAsyncSteps& as) {
+        auto& p = as.parallel(
+                [&](IAsyncSteps& as, ErrorCode code) {
+                    handled = static_cast<const char*>(code);
+                    info = as.state().error_info();
+                },
+                ParallelMode::Threads);
+
+        p.add([](IAsyncSteps& as) { as.error("Failed", "info"); });
+    });
+    root.state().set_unhandled_error([](ErrorCode) {});
+
+    root.execute();
+    run_till_done(reactor, root);
+
+    BOOST_CHECK_EQUAL(handled, "Failed");
+    BOOST_CHECK_EQUAL(info, "info");
+
+    // Without pool
+    AsyncSteps local(reactor);
+    int count = 0;
+
+    local.add([&](IAsyncSteps& as) {
+        auto& p = as.parallel({}, ParallelMode::Threads);
+        p.add([&](IAsyncSteps& as) {
+            BOOST_CHECK(as.tool().is_same_thread());
+            ++count;
+        });
+    });
+    local.execute();
+    run_till_done(reactor, local);
+    BOOST_CHECK_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_threads_cancel) // NOLINT
+{
+    ReactorPool pool(2, &steps_factory);
+    Reactor reactor;
+    std::atomic<int> finished{0};
+    std::atomic<bool> started{false};
+
+    {
+        AsyncSteps root(reactor);
+        root.set_thread_pool(&pool);
+
+        root.add([&](IAsyncSteps& as) {
+            auto& p = as.parallel({}, ParallelMode::Threads);
+            p.add([&](IAsyncSteps&) {
+                started = true;
+                std::this_thread::sleep_for(milliseconds(50));
+                ++finished;
+            });
+        });
+
+        root.execute();
+
+        while (!started) {
+            reactor.iterate();
+            std::this_thread::yield();
+        }
+
+        // Result is discarded, the branch is not waited for
+        root.cancel();
+        BOOST_CHECK(!root.is_running());
+    }
+
+    BOOST_CHECK_EQUAL(finished.load(), 0);
+
+    while (finished == 0) {
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+
+    pool.stop();
+    reactor.run();
+}
+
+BOOST_AUTO_TEST_CASE(parallel_threads_same_worker) // NOLINT
+{
+    ReactorPool pool(1, &steps_factory);
+    std::atomic<bool> destroyed{false};
+    std::atomic<int> finished{0};
+
+    pool.submit([&](futoin::IAsyncTool& tool) {
+        auto* root = new AsyncSteps(tool);
+        root->set_thread_pool(&pool);
+
+        root->add([&, root](IAsyncSteps& as) {
+            auto& p = as.parallel({}, ParallelMode::Threads);
+            p.add([&](IAsyncSteps&) { ++finished; });
+
+            // After the branch is queued to this very worker
+            as.tool().immediate([&, root]() {
+                root->tool().immediate([&, root]() {
+                    delete root;
+                    destroyed = true;
+                });
+            });
+        });
+        root->execute();
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + milliseconds(10000);
+
+    while (!destroyed || (finished == 0)) {
+        BOOST_REQUIRE(std::chrono::steady_clock::now() < deadline);
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+
+    BOOST_CHECK(destroyed.load());
+    pool.stop();
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_each_threads_cancel) // NOLINT
+{
+    static std::atomic<int> live{0};
+    static std::atomic<bool> started{false};
+    static std::atomic<bool> alive{false};
+    static std::atomic<bool> done{false};
+
+    struct Handler
+    {
+        Handler() noexcept
+        {
+            ++live;
+        }
+
+        Handler(const Handler& /*other*/) noexcept
+        {
+            ++live;
+        }
+
+        ~Handler() noexcept
+        {
+            --live;
+        }
+
+        void operator()(IAsyncSteps& /*as*/, std::size_t /*i*/, int& /*v*/)
+                const
+        {
+            started = true;
+            std::this_thread::sleep_for(milliseconds(50));
+            alive = (live.load() > 0);
+            done = true;
+        }
+    };
+
+    ReactorPool pool(2, &steps_factory);
+    Reactor reactor;
+    std::vector<int> values(4);
+
+    {
+        AsyncSteps root(reactor);
+        root.set_thread_pool(&pool);
+
+        root.add([&](IAsyncSteps& as) {
+            as.parallelForEach(
+                    std::ref(values),
+                    Handler(),
+                    0,
+                    values.size(),
+                    ParallelMode::Threads);
+        });
+
+        root.execute();
+
+        while (!started) {
+            reactor.iterate();
+            std::this_thread::yield();
+        }
+
+        // The frame is released while the chunk still runs
+        root.cancel();
+        BOOST_CHECK(!root.is_running());
+    }
+
+    // Released by the branch after the root is gone
+    auto deadline = std::chrono::steady_clock::now() + milliseconds(10000);
+
+    while (!done || (live > 0)) {
+        BOOST_REQUIRE(std::chrono::steady_clock::now() < deadline);
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+
+    BOOST_CHECK(alive.load());
+    pool.stop();
+    reactor.run();
+}
+
+BOOST_AUTO_TEST_CASE(parallel_threads_dropped) // NOLINT
+{
+    ReactorPool pool(1, &steps_factory);
+    Reactor reactor;
+    AsyncSteps root(reactor);
+    std::atomic<bool> started{false};
+    futoin::string handled;
+    int count = 0;
+
+    root.set_thread_pool(&pool);
+    root.state().set_unhandled_error([](ErrorCode) {});
+
+    auto add_parallel = [&]() {
+        root.add([&](IAsyncSteps& as) {
+            auto& p = as.parallel(
+                    [&](IAsyncSteps&, ErrorCode code) {
+                        handled = static_cast<const char*>(code);
+                    },
+                    ParallelMode::Threads);
+
+            // Root is destroyed by stop()
+            p.add([&](IAsyncSteps& as) {
+                started = true;
+                std::this_thread::sleep_for(milliseconds(30));
+                as.waitExternal();
+            });
+
+            // Queued behind the busy worker
+            p.add([&](IAsyncSteps&) { ++count; });
+        });
+    };
+
+    add_parallel();
+    root.execute();
+
+    while (!started) {
+        reactor.iterate();
+        std::this_thread::yield();
+    }
+
+    pool.stop();
+    run_till_done(reactor, root);
+
+    BOOST_CHECK_EQUAL(handled, futoin::errors::InternalError);
+    BOOST_CHECK_EQUAL(count, 0);
+
+    // Submitted after stop
+    handled.clear();
+    started = false;
+    add_parallel();
+    root.execute();
+    run_till_done(reactor, root);
+
+    BOOST_CHECK_EQUAL(handled, futoin::errors::InternalError);
+    BOOST_CHECK(!started);
+    BOOST_CHECK_EQUAL(count, 0);
+}
+
+BOOST_AUTO_TEST_CASE(timeout_cancel) // NOLINT
+{
+    Reactor reactor;
+    AsyncSteps root(reactor);
+    futoin::string handled;
+    int canceled = 0;
+
+    root.add(
+            [&](IAsyncSteps& as) {
+                as.setCancel([&](IAsyncSteps&) { ++canceled; });
+                as.setTimeout(milliseconds(1));
+            },
+            [&](IAsyncSteps& as, ErrorCode code) {
+                handled = static_cast<const char*>(code);
+                as.success();
+            });
+
+    root.execute();
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(handled, futoin::errors::Timeout);
+    BOOST_CHECK_EQUAL(canceled, 1);
+
+    // Root cancel
+    bool waiting = false;
+    root.add([&](IAsyncSteps& as) {
+        as.add([&](IAsyncSteps& as) {
+            as.setCancel([&](IAsyncSteps&) { ++canceled; });
+            waiting = true;
+        });
+    });
+    root.add([&](IAsyncSteps&) { handled = "unreachable"; });
+    root.execute();
+
+    while (!waiting) {
+        reactor.iterate();
+    }
+
+    root.cancel();
+    BOOST_CHECK_EQUAL(canceled, 2);
+    BOOST_CHECK(!root.is_running());
+
+    reactor.run();
+    BOOST_CHECK_EQUAL(handled, futoin::errors::Timeout);
+
+    // Cancel from inside of a step
+    root.add([&](IAsyncSteps& as) {
+        as.setCancel([&](IAsyncSteps&) { ++canceled; });
+        root.cancel();
+    });
+    root.execute();
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(canceled, 3);
+    BOOST_CHECK(!root.is_running());
+
+    // Error unwinding
+    handled.clear();
+    root.add(
+            [&](IAsyncSteps& as) {
+                as.add([&](IAsyncSteps& as) {
+                    as.setCancel([&](IAsyncSteps&) { ++canceled; });
+                    as.error("Fail");
+                });
+            },
+            [&](IAsyncSteps& as, ErrorCode code) {
+                handled = static_cast<const char*>(code);
+                as.success();
+            });
+    root.execute();
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(handled, "Fail");
+    BOOST_CHECK_EQUAL(canceled, 4);
+}
+
+BOOST_AUTO_TEST_CASE(sync) // NOLINT
+{
+    Reactor reactor;
+    AsyncSteps root(reactor);
+    CountingSync mtx;
+
+    root.sync(mtx, [&](IAsyncSteps& as) {
+        BOOST_CHECK_EQUAL(mtx.locks, 1);
+        BOOST_CHECK_EQUAL(mtx.unlocks, 0);
+        as.add([&](IAsyncSteps&) { BOOST_CHECK_EQUAL(mtx.unlocks, 0); });
+    });
+    root.add([&](IAsyncSteps&) { BOOST_CHECK_EQUAL(mtx.unlocks, 1); });
+    root.sync(mtx, [&](IAsyncSteps& as) { as.error("Fail"); });
+    root.state().set_unhandled_error([](ErrorCode) {});
+
+    root.execute();
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(mtx.locks, 2);
+    BOOST_CHECK_EQUAL(mtx.unlocks, 2);
+}
+
+BOOST_AUTO_TEST_CASE(await_promise) // NOLINT
+{
+    Reactor reactor;
+    AsyncSteps root(reactor);
+    std::promise<int> ext;
+    int tracked = 0;
+
+    root.add([&](IAsyncSteps& as) {
+        as.stack<Tracked>(tracked);
+        as.tool().deferred(milliseconds(1), [&]() { ext.set_value(3); });
+        as.await(ext.get_future());
+    });
+    root.add([&](IAsyncSteps& as, int i) {
+        BOOST_CHECK_EQUAL(tracked, 0);
+        as.stack<Tracked>(tracked);
+        as(i * 2);
+    });
+
+    auto res = root.promise<int>();
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(res.get(), 6);
+    BOOST_CHECK_EQUAL(tracked, 0);
+
+    // Unhandled error
+    root.add([](IAsyncSteps& as) { as.error("Failed"); });
+    auto failed = root.promise();
+    reactor.run();
+
+    BOOST_CHECK_THROW(failed.get(), futoin::Error);
+
+    // Instance
+    auto other = root.newInstance();
+    int count = 0;
+    other->add([&](IAsyncSteps&) { ++count; });
+    other->execute();
+    reactor.run();
+    BOOST_CHECK_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_CASE(inline_continuation) // NOLINT
+{
+    CountingReactor reactor;
+    AsyncSteps root(reactor);
+    std::size_t count = 0;
+
+    auto run_steps = [&]() {
+        reactor.posts = 0;
+
+        for (int i = 0; i < 100; ++i) {
+            root.add([&](IAsyncSteps& as) {
+                ++count;
+                as.add([&](IAsyncSteps& as) { as(1); });
+                as.add([&](IAsyncSteps&, int v) { count += v; });
+            });
+        }
+
+        const auto before = count;
+        root.execute();
+        BOOST_CHECK_EQUAL(count, before);
+        reactor.run();
+        BOOST_CHECK_EQUAL(count, before + 200);
+        BOOST_CHECK(!root.is_running());
+        return reactor.posts;
+    };
+
+    const auto async_posts = run_steps();
+    BOOST_CHECK_EQUAL(root.inline_depth(), 0U);
+
+    root.set_inline_depth(16);
+    auto inst = root.newInstance();
+    BOOST_CHECK_EQUAL(static_cast<AsyncSteps&>(*inst).inline_depth(), 16U);
+    const auto inline_posts = run_steps();
+
+    BOOST_CHECK_EQUAL(count, 400U);
+    BOOST_CHECK_LT(inline_posts * 8, async_posts);
+    BOOST_CHECK_GT(inline_posts, 1U);
+
+    // Errors and loops
+    std::vector<int> order;
+
+    root.repeat(5, [&](IAsyncSteps& as, std::size_t i) {
+        if (i == 1) {
+            as.continueLoop();
+        }
+
+        if (i == 3) {
+            as.breakLoop();
+        }
+
+        order.push_back(static_cast<int>(i));
+    });
+    root.add(
+            [&](IAsyncSteps& as) { as.error("Failed"); },
+            [&](IAsyncSteps& as, ErrorCode) {
+                order.push_back(-1);
+                as();
+            });
+    root.add([&](IAsyncSteps&) { order.push_back(10); });
+
+    root.execute();
+    BOOST_CHECK(order.empty());
+    reactor.run();
+    BOOST_CHECK((order == std::vector<int>{0, 2, -1, 10}));
+
+    // relinquish() lets other roots run
+    AsyncSteps other(reactor);
+    other.set_inline_depth(16);
+    order.clear();
+
+    root.add([&](IAsyncSteps& as) {
+        order.push_back(1);
+        as.relinquish();
+    });
+    root.add([&](IAsyncSteps&) { order.push_back(3); });
+    other.add([&](IAsyncSteps&) { order.push_back(2); });
+
+    root.execute();
+    other.execute();
+    reactor.run();
+    BOOST_CHECK((order == std::vector<int>{1, 2, 3}));
+
+    // Branches start through the tool, then continue inline
+    order.clear();
+
+    root.add([&](IAsyncSteps& as) {
+        auto& p = as.parallel();
+
+        for (int i = 0; i < 2; ++i) {
+            p.add([&, i](IAsyncSteps& as) {
+                order.push_back(i);
+                as.add([&, i](IAsyncSteps&) { order.push_back(10 + i); });
+            });
+        }
+    });
+
+    root.execute();
+    reactor.run();
+    BOOST_CHECK((order == std::vector<int>{0, 10, 1, 11}));
+}
+
+BOOST_AUTO_TEST_CASE(inline_external) // NOLINT
+{
+    Reactor reactor;
+    AsyncSteps root(reactor);
+    IAsyncSteps* ext = nullptr;
+    int count = 0;
+
+    root.set_inline_depth(8);
+
+    auto wait_ext = [&](IAsyncSteps& as) {
+        ext = &as;
+        as.waitExternal();
+    };
+
+    root.add(wait_ext);
+    root.add([&](IAsyncSteps&) { ++count; });
+    root.add([&](IAsyncSteps&) { ++count; });
+
+    root.execute();
+    reactor.run();
+    BOOST_REQUIRE(ext != nullptr);
+
+    // Next steps do not run in the caller's stack
+    ext->success();
+    BOOST_CHECK_EQUAL(count, 0);
+    BOOST_CHECK(root.is_running());
+
+    reactor.run();
+    BOOST_CHECK_EQUAL(count, 2);
+    BOOST_CHECK(!root.is_running());
+
+    // Same for errors
+    count = 0;
+    ext = nullptr;
+
+    root.add(wait_ext, [&](IAsyncSteps& as, ErrorCode) {
+        ++count;
+        as.add([&](IAsyncSteps&) { count += 10; });
+    });
+    root.add([&](IAsyncSteps&) { count += 100; });
+
+    root.execute();
+    reactor.run();
+    BOOST_REQUIRE(ext != nullptr);
+
+    ext->errorNoThrow("Failed");
+    BOOST_CHECK_EQUAL(count, 1);
+    BOOST_CHECK(root.is_running());
+
+    reactor.run();
+    BOOST_CHECK_EQUAL(count, 111);
+    BOOST_CHECK(!root.is_running());
+}
+
+BOOST_AUTO_TEST_CASE(inline_depth_limit) // NOLINT
+{
+    CountingReactor reactor;
+
+    constexpr std::size_t DEPTH = 4;
+    constexpr std::size_t STEPS = 20;
+
+    AsyncSteps first(reactor);
+    AsyncSteps second(reactor);
+    std::string order;
+
+    first.set_inline_depth(DEPTH);
+    second.set_inline_depth(DEPTH);
+
+    for (std::size_t i = 0; i < STEPS; ++i) {
+        first.add([&](IAsyncSteps&) { order += 'a'; });
+        second.add([&](IAsyncSteps&) { order += 'b'; });
+    }
+
+    first.execute();
+    second.execute();
+    reactor.immediate([&]() { order += '-'; });
+    BOOST_CHECK_EQUAL(reactor.posts, 2U);
+
+    reactor.posts = 0;
+    reactor.run();
+
+    // DEPTH inline transitions follow a step run through the tool
+    std::string expected;
+
+    for (std::size_t i = 0; i < STEPS; i += DEPTH + 1) {
+        expected += std::string(DEPTH + 1, 'a');
+        expected += std::string(DEPTH + 1, 'b');
+
+        if (i == 0) {
+            expected += '-';
+        }
+    }
+
+    BOOST_CHECK_EQUAL(order, expected);
+
+    // One post per chunk for each root, the last one completes it
+    BOOST_CHECK_EQUAL(reactor.posts, 2 * (STEPS / (DEPTH + 1)));
+}
+
+BOOST_AUTO_TEST_CASE(steady_memory) // NOLINT
+{
+    CountingMemPool mem_pool;
+
+    {
+        Reactor reactor(mem_pool);
+        AsyncSteps root(reactor);
+        int count = 0;
+        int tracked = 0;
+
+        auto cycle = [&]() {
+            // Root stack lives till completion
+            root.stack<Tracked>(tracked);
+            root.stack(200);
+            root.add([&](IAsyncSteps& as) {
+                as.add([&](IAsyncSteps& as) { as(1); });
+                as.add([&](IAsyncSteps& as, int i) {
+                    count += i;
+                    as.stack<int>(1);
+                });
+            });
+            root.repeat(3, [&](IAsyncSteps& as, std::size_t) {
+                auto& p = as.parallel();
+                p.add([&](IAsyncSteps&) { ++count; });
+                p.add([&](IAsyncSteps&) { ++count; });
+            });
+            root.add(
+                    [&](IAsyncSteps& as) { as.error("Handled"); },
+                    [&](IAsyncSteps& as, ErrorCode) { as(); });
+            root.execute();
+            reactor.run();
+        };
+
+        cycle();
+        auto allocs = mem_pool.allocs;
+
+        for (int i = 0; i < 10; ++i) {
+            cycle();
+            BOOST_CHECK_EQUAL(tracked, 0);
+        }
+
+        BOOST_CHECK_EQUAL(count, 77);
+        BOOST_CHECK_EQUAL(mem_pool.allocs, allocs);
+
+        // Unhandled error and cancel
+        int alive = 0;
+        root.state().set_unhandled_error(
+                [&](ErrorCode) { alive = tracked; });
+
+        for (int i = 0; i < 10; ++i) {
+            root.stack<Tracked>(tracked);
+            root.stack(200);
+            root.add([](IAsyncSteps& as) { as.error("Fail"); });
+            root.execute();
+            reactor.run();
+            BOOST_CHECK_EQUAL(alive, 1);
+            BOOST_CHECK_EQUAL(tracked, 0);
+
+            root.stack<Tracked>(tracked);
+            root.stack(200);
+            root.add([](IAsyncSteps& as) { as.waitExternal(); });
+            root.execute();
+            reactor.run();
+            root.cancel();
+            BOOST_CHECK_EQUAL(tracked, 0);
+        }
+
+        BOOST_CHECK_EQUAL(mem_pool.allocs, allocs);
+
+        root.release_memory();
+    }
+
+    BOOST_CHECK_EQUAL(mem_pool.allocs, mem_pool.deallocs);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // NOLINT
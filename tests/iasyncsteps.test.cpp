@@ -18,10 +18,12 @@
 #include <boost/test/unit_test.hpp>
 
 #include <array>
+#include <string>
 #include <vector>
 
 #include <futoin/iasyncsteps.hpp>
 #include <futoin/imempool.hpp>
+#include <futoin/ri/steparena.hpp>
 
 using namespace futoin;
 
@@ -41,6 +43,28 @@ struct TestMemPool : IMemPool
     void release_memory() noexcept override {}
 };
 
+struct CountingMemPool : IMemPool
+{
+    void* allocate(size_t object_size, size_t count) noexcept override
+    {
+        ++allocs;
+        return parent.allocate(object_size, count);
+    }
+
+    void deallocate(
+            void* ptr, size_t object_size, size_t count) noexcept override
+    {
+        ++deallocs;
+        parent.deallocate(ptr, object_size, count);
+    }
+
+    void release_memory() noexcept override {}
+
+    IMemPool& parent{GlobalMemPool::get_default()};
+    size_t allocs{0};
+    size_t deallocs{0};
+};
+
 struct TestSteps : IAsyncSteps
 {
     TestSteps() :
@@ -114,10 +138,10 @@ struct TestSteps : IAsyncSteps
     void await_impl(AwaitPass /*cb*/) noexcept override {}
 
     void* stack(
-            std::size_t /*object_size*/,
-            StackDestroyHandler /*destroy_cb*/) noexcept override
+            std::size_t object_size,
+            StackDestroyHandler destroy_cb) noexcept override
     {
-        return nullptr;
+        return arena_.allocate(object_size, destroy_cb);
     }
 
     FutoInAsyncSteps& binary() noexcept override
@@ -142,6 +166,7 @@ struct TestSteps : IAsyncSteps
     TestMemPool mem_pool_;
     asyncsteps::State state_;
     asyncsteps::LoopState loop_state_;
+    ri::StepArena arena_;
     FutoInAsyncSteps binary_api_{nullptr};
     IAsyncTool* async_tool_{nullptr};
 };
@@ -169,6 +194,118 @@ BOOST_AUTO_TEST_CASE(success_with_args) // NOLINT
     as.success(std::vector<int>());
 }
 
+BOOST_AUTO_TEST_CASE(next_args_count) // NOLINT
+{
+    asyncsteps::NextArgs args;
+
+    args.assign(1, 1.0, "str", true);
+    BOOST_CHECK_EQUAL(args.size(), 4U);
+    BOOST_CHECK_EQUAL(any_cast<futoin::string>(args[2]), "str");
+
+    args.assign(2);
+    BOOST_CHECK_EQUAL(args.size(), 1U);
+    BOOST_CHECK_EQUAL(any_cast<int>(args[0]), 2);
+    BOOST_CHECK(!args[1].has_value());
+    BOOST_CHECK(!args[3].has_value());
+
+    args.assign();
+    BOOST_CHECK_EQUAL(args.size(), 0U);
+    BOOST_CHECK(!args[0].has_value());
+
+    // Model args skip NoArg defaults
+    BOOST_CHECK_EQUAL(asyncsteps::NextArgs::Model<int>::instance.size(), 1U);
+    BOOST_CHECK(!asyncsteps::NextArgs::Model<int>::instance[1].has_value());
+
+    FutoInArgs fargs{};
+    args.assign(3, futoin::string("abc"));
+    args.moveTo(fargs);
+    BOOST_CHECK(fargs.arg2.type == nullptr);
+
+    args.assign();
+    args.moveFrom(fargs);
+    BOOST_CHECK_EQUAL(any_cast<int>(args[0]), 3);
+    BOOST_CHECK_EQUAL(any_cast<futoin::string>(args[1]), "abc");
+    BOOST_CHECK_EQUAL(args.size(), 2U);
+
+    // Stale slots past the binary args are dropped
+    args.assign(1, 2, 3, 4);
+    FutoInArgs one{};
+    asyncsteps::NextArgs(5).moveTo(one);
+    args.moveFrom(one);
+    BOOST_CHECK_EQUAL(args.size(), 1U);
+    BOOST_CHECK_EQUAL(any_cast<int>(args[0]), 5);
+    BOOST_CHECK(!args[1].has_value());
+    BOOST_CHECK(!args[3].has_value());
+
+    FutoInArgs none{};
+    args.moveFrom(none);
+    BOOST_CHECK_EQUAL(args.size(), 0U);
+    BOOST_CHECK(!args[0].has_value());
+}
+
+BOOST_AUTO_TEST_CASE(next_args_binary_pool) // NOLINT
+{
+    struct Large
+    {
+        std::array<char, 256> data;
+    };
+
+    CountingMemPool mem_pool;
+    GlobalMemPool::set_thread_default(mem_pool);
+
+    {
+        asyncsteps::NextArgs args;
+        FutoInArgs fargs{};
+
+        args.assign(
+                futoin::string(300, 'x'),
+                std::vector<int>{1, 2, 3},
+                std::vector<bool>{true, false},
+                Large{});
+        auto allocs = mem_pool.allocs;
+
+        args.moveTo(fargs);
+        BOOST_CHECK_EQUAL(fargs.arg1.length, 3U);
+        BOOST_CHECK(!reinterpret_cast<const bool*>(fargs.arg2.p)[1]);
+        // Holders and packed bools only, no payload copies
+        BOOST_CHECK_EQUAL(mem_pool.allocs - allocs, 5U);
+
+        args.assign();
+        args.moveFrom(fargs);
+        BOOST_CHECK_EQUAL(any_cast<futoin::string>(args[0]).size(), 300U);
+        BOOST_CHECK_EQUAL(any_cast<std::vector<int>>(args[1])[2], 3);
+        BOOST_CHECK(any_cast<std::vector<bool>>(args[2])[0]);
+        any_cast<const Large&>(args[3]);
+    }
+
+    GlobalMemPool::reset_thread_default();
+    BOOST_CHECK_EQUAL(mem_pool.allocs, mem_pool.deallocs);
+}
+
+BOOST_AUTO_TEST_CASE(any_reassign) // NOLINT
+{
+    any a{1};
+    a = 2;
+    BOOST_CHECK_EQUAL(any_cast<int>(a), 2);
+
+    a = 3.0;
+    BOOST_CHECK_EQUAL(any_cast<double>(a), 3.0);
+
+    a = futoin::string("str");
+    a = 4;
+    BOOST_CHECK_EQUAL(any_cast<int>(a), 4);
+    BOOST_CHECK(a.type() == typeid(int));
+
+    a.reset();
+    BOOST_CHECK(!a.has_value());
+    BOOST_CHECK(a.type() == typeid(void));
+
+#ifndef FUTOIN_NO_EXC
+    const any c{1};
+    BOOST_CHECK_THROW(any_cast<long>(c), std::bad_cast);
+#endif
+}
+
 BOOST_AUTO_TEST_CASE(add_with_args) // NOLINT
 {
     TestSteps ts;
@@ -455,5 +592,198 @@ BOOST_AUTO_TEST_CASE(relinquish) // NOLINT
     TestSteps ts;
     IAsyncSteps& as = ts;
 
+    BOOST_CHECK(as.state().priority() == IAsyncTool::Priority::Normal);
+    as.state().set_priority(IAsyncTool::Priority::High);
+    BOOST_CHECK(as.state().priority() == IAsyncTool::Priority::High);
+
     as.relinquish();
 }
+
+BOOST_AUTO_TEST_CASE(hashed_key) // NOLINT
+{
+    constexpr asyncsteps::HashedKey key("SomeVar");
+    static_assert(key.length == 7, "compile-time length");
+
+    BOOST_CHECK_EQUAL(
+            key.hash, asyncsteps::state_key_hash::runtime("SomeVar", 7));
+    BOOST_CHECK(asyncsteps::HashedKey("a").hash
+                != asyncsteps::HashedKey("b").hash);
+}
+
+BOOST_AUTO_TEST_CASE(hashed_state) // NOLINT
+{
+    asyncsteps::HashedState hs(GlobalMemPool::get_default());
+    asyncsteps::BaseState& state = hs;
+
+    state["SomeVar"] = 1;
+    auto& ref = any_cast<int&>(state["SomeVar"]);
+    BOOST_CHECK_EQUAL(ref, 1);
+
+    // Same item with runtime keys
+    BOOST_CHECK_EQUAL(
+            any_cast<int>(state[asyncsteps::BaseState::key_type("SomeVar")]),
+            1);
+    state[asyncsteps::BaseState::key_type("Other")] = 2;
+    BOOST_CHECK_EQUAL(any_cast<int>(state["Other"]), 2);
+
+    // Growth keeps references valid
+    for (int i = 0; i < 1000; ++i) {
+        state[asyncsteps::BaseState::key_type(std::to_string(i).c_str())] = i;
+    }
+
+    BOOST_CHECK_EQUAL(hs.size(), 1002U);
+    BOOST_CHECK_EQUAL(&ref, &any_cast<int&>(state["SomeVar"]));
+    BOOST_CHECK_EQUAL(
+            any_cast<int>(state[asyncsteps::BaseState::key_type("999")]),
+            999);
+}
+
+BOOST_AUTO_TEST_CASE(hashed_state_lookup) // NOLINT
+{
+    CountingMemPool mem_pool;
+    asyncsteps::HashedState hs(mem_pool);
+    asyncsteps::BaseState& state = hs;
+    const std::array<asyncsteps::HashedKey, 9> keys{
+            {"a", "b", "c", "d", "e", "f", "g", "h", "i"}};
+
+    // Right below the growth threshold of the initial table
+    for (std::size_t i = 0; i < asyncsteps::HashedState::INITIAL_CAPACITY / 2;
+         ++i) {
+        state[keys[i]] = static_cast<int>(i);
+    }
+
+    auto allocs = mem_pool.allocs;
+
+    for (std::size_t i = 0; i < asyncsteps::HashedState::INITIAL_CAPACITY / 2;
+         ++i) {
+        BOOST_CHECK_EQUAL(any_cast<int>(state[keys[i]]), static_cast<int>(i));
+    }
+
+    BOOST_CHECK_EQUAL(mem_pool.allocs, allocs);
+
+    // New item grows the table
+    state[keys[8]] = 8;
+    BOOST_CHECK_GT(mem_pool.allocs, allocs);
+    BOOST_CHECK_EQUAL(hs.size(), 9U);
+
+    for (std::size_t i = 0; i < 9; ++i) {
+        BOOST_CHECK_EQUAL(any_cast<int>(state[keys[i]]), static_cast<int>(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hashed_state_access) // NOLINT
+{
+    struct HashedSteps : TestSteps
+    {
+        HashedSteps() : hashed_(GlobalMemPool::get_default()) {}
+
+        asyncsteps::BaseState& state() noexcept override
+        {
+            return hashed_;
+        }
+
+        asyncsteps::HashedState hashed_;
+    };
+
+    HashedSteps ts;
+    IAsyncSteps& as = ts;
+
+    constexpr asyncsteps::HashedKey counter("counter");
+
+    BOOST_CHECK_EQUAL(as.state(counter, 10), 10);
+    as.state<int>("counter") += 1;
+    BOOST_CHECK_EQUAL(as.state<int>(counter), 11);
+    BOOST_CHECK_EQUAL(as.state("counter", 0), 11);
+    BOOST_CHECK_EQUAL(
+            as.state<int>(asyncsteps::BaseState::key_type("counter")), 11);
+}
+
+BOOST_AUTO_TEST_CASE(typed_state) // NOLINT
+{
+    static asyncsteps::StateKey<int> counter;
+    static asyncsteps::StateKey<std::vector<int>> order;
+    static asyncsteps::StateKey<std::string> name;
+
+    BOOST_CHECK(counter.index() != order.index());
+
+    asyncsteps::State st(GlobalMemPool::get_default());
+    asyncsteps::BaseState& state = st;
+
+    BOOST_CHECK(!state.has_slot(counter));
+    BOOST_CHECK_EQUAL(state.slot(counter), 0);
+    BOOST_CHECK(state.has_slot(counter));
+
+    state.slot(counter) = 3;
+    state.slot(order).push_back(1);
+    BOOST_CHECK_EQUAL(state.slot(counter, 10), 3);
+    BOOST_CHECK_EQUAL(state.slot(name, "default"), "default");
+    BOOST_CHECK_EQUAL(state.slot(order).size(), 1U);
+
+    // String keys keep working
+    state["SomeVar"] = 1;
+    BOOST_CHECK_EQUAL(any_cast<int>(state["SomeVar"]), 1);
+}
+
+BOOST_AUTO_TEST_CASE(typed_state_access) // NOLINT
+{
+    static asyncsteps::StateKey<int> counter;
+
+    struct SlotSteps : TestSteps
+    {
+        SlotSteps() : hashed_(GlobalMemPool::get_default()) {}
+
+        asyncsteps::BaseState& state() noexcept override
+        {
+            return hashed_;
+        }
+
+        asyncsteps::HashedState hashed_;
+    };
+
+    SlotSteps ts;
+    IAsyncSteps& as = ts;
+
+    BOOST_CHECK_EQUAL(as.state(counter, 10), 10);
+    ++as.state(counter);
+    BOOST_CHECK_EQUAL(as.state(counter), 11);
+}
+
+BOOST_AUTO_TEST_CASE(any_large_pool) // NOLINT
+{
+    struct Large
+    {
+        std::array<void*, FUTOIN_ANY_INLINE_PTRS + 1> data;
+    };
+
+    struct SizedMemPool : IMemPool
+    {
+        void* allocate(size_t object_size, size_t count) noexcept override
+        {
+            return parent.allocate(object_size, count);
+        }
+
+        void deallocate(
+                void* ptr, size_t object_size, size_t count) noexcept override
+        {
+            parent.deallocate(ptr, object_size, count);
+        }
+
+        void release_memory() noexcept override {}
+
+        IMemPool& mem_pool(size_t object_size, bool optimize) noexcept override
+        {
+            requested = optimize ? object_size : 0;
+            return *this;
+        }
+
+        IMemPool& parent{GlobalMemPool::get_default()};
+        size_t requested{0};
+    };
+
+    SizedMemPool mem_pool;
+    GlobalMemPool::set_thread_default(mem_pool);
+    any a{Large{}};
+    GlobalMemPool::reset_thread_default();
+
+    BOOST_CHECK_EQUAL(mem_pool.requested, sizeof(Large));
+}
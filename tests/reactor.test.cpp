@@ -0,0 +1,995 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <futoin/ri/reactor.hpp>
+
+#ifdef __linux__
+#    include <poll.h>
+#endif
+
+using futoin::IAsyncTool;
+using futoin::ri::Reactor;
+using std::chrono::milliseconds;
+
+namespace {
+    class SimulatedReactor : public Reactor
+    {
+    public:
+        void shift(Tick ms) noexcept
+        {
+            offset_ += milliseconds(ms);
+        }
+
+    protected:
+        Clock::time_point now() const noexcept override
+        {
+            return base_ + offset_;
+        }
+
+    private:
+        const Clock::time_point base_{Clock::now()};
+        Clock::duration offset_{0};
+    };
+
+    struct Repost
+    {
+        Reactor* reactor;
+        int* count;
+
+        void operator()() const
+        {
+            ++(*count);
+            reactor->immediate_priority(
+                    IAsyncTool::Priority::High, Repost{reactor, count});
+        }
+    };
+
+    struct Push
+    {
+        std::vector<int>* order;
+        int value;
+
+        void operator()() const
+        {
+            order->push_back(value);
+        }
+    };
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(reactor) // NOLINT
+
+BOOST_AUTO_TEST_CASE(immediate_fifo) // NOLINT
+{
+    Reactor reactor;
+    std::vector<int> order;
+
+    for (int i = 0; i < 200; ++i) {
+        reactor.immediate([&order, i]() { order.push_back(i); });
+    }
+
+    BOOST_CHECK_EQUAL(reactor.immediate_count(), 200U);
+
+    auto res = reactor.iterate();
+    BOOST_CHECK(!res.have_work);
+    BOOST_REQUIRE_EQUAL(order.size(), 200U);
+
+    for (int i = 0; i < 200; ++i) {
+        BOOST_CHECK_EQUAL(order[i], i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(immediate_nested) // NOLINT
+{
+    Reactor reactor;
+    int count = 0;
+
+    reactor.immediate([&]() {
+        ++count;
+        reactor.immediate([&]() { ++count; });
+    });
+
+    auto res = reactor.iterate();
+    BOOST_CHECK_EQUAL(count, 1);
+    BOOST_CHECK(res.have_work);
+    BOOST_CHECK_EQUAL(res.delay.count(), 0);
+
+    res = reactor.iterate();
+    BOOST_CHECK_EQUAL(count, 2);
+    BOOST_CHECK(!res.have_work);
+}
+
+BOOST_AUTO_TEST_CASE(immediate_batch) // NOLINT
+{
+    Reactor reactor;
+    std::vector<int> order;
+
+    // Larger than a slot chunk
+    const std::size_t count = Reactor::SLOT_CHUNK * 2 + 3;
+    std::vector<Push> fns;
+    std::vector<IAsyncTool::CallbackPass> cbs;
+    std::vector<IAsyncTool::Handle> handles(count);
+
+    reactor.immediate([&order]() { order.push_back(-1); });
+
+    // Functors must outlive the batch call
+    for (std::size_t i = 0; i < count; ++i) {
+        fns.push_back({&order, static_cast<int>(i)});
+    }
+
+    for (auto& f : fns) {
+        cbs.emplace_back(std::move(f));
+    }
+
+    reactor.immediate_batch(cbs.data(), count, handles.data());
+    BOOST_CHECK_EQUAL(reactor.immediate_count(), count + 1);
+
+    // Default implementation
+    Push extra[] = {{&order, 1000}, {&order, 1001}};
+    cbs.clear();
+    cbs.emplace_back(std::move(extra[0]));
+    cbs.emplace_back(std::move(extra[1]));
+    reactor.IAsyncTool::immediate_batch(cbs.data(), cbs.size());
+
+    handles[0].cancel();
+    handles[count - 1].cancel();
+    BOOST_CHECK(!handles[0]);
+    BOOST_CHECK(handles[1]);
+
+    reactor.immediate_batch(nullptr, 0);
+    reactor.iterate();
+
+    BOOST_REQUIRE_EQUAL(order.size(), count + 1);
+    BOOST_CHECK_EQUAL(order.front(), -1);
+
+    for (std::size_t i = 1; i < count - 1; ++i) {
+        BOOST_CHECK_EQUAL(order[i], static_cast<int>(i));
+    }
+
+    BOOST_CHECK_EQUAL(order[count - 1], 1000);
+    BOOST_CHECK_EQUAL(order[count], 1001);
+    BOOST_CHECK(!handles[1]);
+}
+
+BOOST_AUTO_TEST_CASE(immediate_batch_cross_thread) // NOLINT
+{
+    Reactor reactor;
+    std::vector<int> order;
+    std::vector<Push> fns;
+    std::vector<IAsyncTool::CallbackPass> cbs;
+    std::vector<IAsyncTool::Handle> handles(3);
+
+    for (int i = 0; i < 3; ++i) {
+        fns.push_back({&order, i});
+    }
+
+    for (auto& f : fns) {
+        cbs.emplace_back(std::move(f));
+    }
+
+    // Goes through the inbox, not the owner lanes
+    std::thread([&]() {
+        reactor.immediate_batch(cbs.data(), cbs.size(), handles.data());
+    }).join();
+
+    BOOST_CHECK_EQUAL(reactor.immediate_count(), 0U);
+    BOOST_CHECK(!handles[0]);
+
+    reactor.iterate();
+
+    BOOST_CHECK((order == std::vector<int>{0, 1, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(priority_lanes) // NOLINT
+{
+    using Priority = IAsyncTool::Priority;
+
+    Reactor reactor;
+    std::vector<int> order;
+    std::vector<Push> fns;
+
+    reactor.set_lane_burst(2);
+    BOOST_CHECK_EQUAL(reactor.lane_burst(), 2U);
+
+    fns.push_back({&order, 100});
+
+    for (int i = 10; i < 13; ++i) {
+        fns.push_back({&order, i});
+    }
+
+    for (int i = 0; i < 6; ++i) {
+        fns.push_back({&order, i});
+    }
+
+    fns.push_back({&order, -1});
+
+    reactor.immediate_priority(Priority::Low, std::move(fns[0]));
+
+    for (std::size_t i = 1; i < 4; ++i) {
+        reactor.immediate(std::move(fns[i]));
+    }
+
+    for (std::size_t i = 4; i < 10; ++i) {
+        reactor.immediate_priority(Priority::High, std::move(fns[i]));
+    }
+
+    auto h = reactor.immediate_priority(Priority::High, std::move(fns[10]));
+    BOOST_CHECK_EQUAL(reactor.immediate_count(Priority::High), 7U);
+    BOOST_CHECK_EQUAL(reactor.immediate_count(Priority::Normal), 3U);
+    BOOST_CHECK_EQUAL(reactor.immediate_count(Priority::Low), 1U);
+    BOOST_CHECK_EQUAL(reactor.immediate_count(), 11U);
+
+    h.cancel();
+    BOOST_CHECK_EQUAL(reactor.immediate_count(Priority::High), 6U);
+
+    reactor.iterate();
+
+    // Lower lanes get a turn after two callbacks of higher lanes
+    const std::vector<int> expected{0, 1, 10, 100, 2, 11, 3, 4, 12, 5};
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+            order.begin(), order.end(), expected.begin(), expected.end());
+
+    // Default implementation ignores priority
+    reactor.IAsyncTool::immediate_priority(Priority::High, []() {});
+    BOOST_CHECK_EQUAL(reactor.immediate_count(Priority::Normal), 1U);
+
+    reactor.set_lane_burst(0);
+    BOOST_CHECK_EQUAL(reactor.lane_burst(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(priority_starvation) // NOLINT
+{
+    Reactor reactor;
+    int high = 0;
+    int low = 0;
+
+    reactor.set_lane_burst(2);
+    reactor.immediate_priority(
+            IAsyncTool::Priority::High, Repost{&reactor, &high});
+    reactor.immediate_priority(
+            IAsyncTool::Priority::Low, [&low]() { ++low; });
+
+    // Skips are counted across budgeted cycles
+    for (int i = 0; (i < 10) && (low == 0); ++i) {
+        reactor.iterate(IAsyncTool::CycleBudget(1));
+    }
+
+    BOOST_CHECK_EQUAL(high, 2);
+    BOOST_CHECK_EQUAL(low, 1);
+}
+
+BOOST_AUTO_TEST_CASE(priority_cross_thread) // NOLINT
+{
+    using Priority = IAsyncTool::Priority;
+
+    Reactor reactor;
+    std::vector<int> order;
+    Push low{&order, 2};
+    Push high{&order, 1};
+
+    std::thread([&]() {
+        reactor.immediate_priority(Priority::Low, std::move(low));
+        reactor.immediate_priority(Priority::High, std::move(high));
+    }).join();
+
+    reactor.iterate();
+
+    BOOST_REQUIRE_EQUAL(order.size(), 2U);
+    BOOST_CHECK_EQUAL(order[0], 1);
+    BOOST_CHECK_EQUAL(order[1], 2);
+}
+
+BOOST_AUTO_TEST_CASE(iterate_budget) // NOLINT
+{
+    Reactor reactor;
+    int ran = 0;
+
+    for (int i = 0; i < 100; ++i) {
+        reactor.immediate([&ran]() { ++ran; });
+    }
+
+    reactor.deferred(milliseconds(0), [&ran]() { ++ran; });
+    std::this_thread::sleep_for(milliseconds(2));
+
+    IAsyncTool::CycleStats stats;
+    auto res = reactor.iterate(IAsyncTool::CycleBudget(10), &stats);
+
+    BOOST_CHECK(res.have_work);
+    BOOST_CHECK_EQUAL(res.delay.count(), 0);
+    BOOST_CHECK_EQUAL(ran, 10);
+    BOOST_CHECK_EQUAL(stats.callbacks, 10U);
+    BOOST_CHECK_EQUAL(stats.expired, 1U);
+    BOOST_CHECK_EQUAL(stats.pending, 91U);
+    BOOST_CHECK(stats.exhausted);
+
+    res = reactor.iterate(IAsyncTool::CycleBudget(), &stats);
+    BOOST_CHECK(!res.have_work);
+    BOOST_CHECK_EQUAL(ran, 101);
+    BOOST_CHECK_EQUAL(stats.callbacks, 91U);
+    BOOST_CHECK_EQUAL(stats.pending, 0U);
+    BOOST_CHECK(!stats.exhausted);
+
+    // Default implementation ignores budget
+    for (int i = 0; i < 10; ++i) {
+        reactor.immediate([&ran]() { ++ran; });
+    }
+
+    reactor.IAsyncTool::iterate(IAsyncTool::CycleBudget(1), &stats);
+    BOOST_CHECK_EQUAL(ran, 111);
+    BOOST_CHECK_EQUAL(stats.callbacks, 0U);
+}
+
+BOOST_AUTO_TEST_CASE(iterate_cancel) // NOLINT
+{
+    struct Ctx
+    {
+        Reactor reactor;
+        int ran{0};
+        int late{0};
+        IAsyncTool::Handle victim;
+        IAsyncTool::Handle victim_high;
+    } ctx;
+    auto* c = &ctx;
+    const auto high = IAsyncTool::Priority::High;
+
+    ctx.reactor.immediate_priority(high, [c, high]() {
+        ++(c->ran);
+        c->victim.cancel();
+        c->victim_high.cancel();
+
+        // Must not take the freed snapshot places
+        c->reactor.immediate([c]() { ++(c->late); });
+        c->reactor.immediate_priority(high, [c]() { ++(c->late); });
+    });
+    ctx.victim_high =
+            ctx.reactor.immediate_priority(high, [c]() { c->ran += 100; });
+    ctx.reactor.immediate_priority(high, [c]() { ++(c->ran); });
+    ctx.victim = ctx.reactor.immediate([c]() { c->ran += 100; });
+    ctx.reactor.immediate([c]() { ++(c->ran); });
+
+    // Budget is not used up, only live snapshot callbacks run
+    IAsyncTool::CycleStats stats;
+    ctx.reactor.iterate(IAsyncTool::CycleBudget(10), &stats);
+    BOOST_CHECK_EQUAL(ctx.ran, 3);
+    BOOST_CHECK_EQUAL(ctx.late, 0);
+    BOOST_CHECK_EQUAL(stats.callbacks, 3U);
+    BOOST_CHECK_EQUAL(stats.pending, 2U);
+    BOOST_CHECK(!stats.exhausted);
+
+    ctx.reactor.iterate();
+    BOOST_CHECK_EQUAL(ctx.late, 2);
+
+    // Single lane path, budget matches the live snapshot
+    ctx.ran = 0;
+    ctx.reactor.immediate([c]() {
+        ++(c->ran);
+        c->victim.cancel();
+        c->reactor.immediate([c]() { ++(c->late); });
+    });
+    ctx.victim = ctx.reactor.immediate([c]() { c->ran += 100; });
+    ctx.reactor.immediate([c]() { ++(c->ran); });
+
+    ctx.reactor.iterate(IAsyncTool::CycleBudget(2), &stats);
+    BOOST_CHECK_EQUAL(ctx.ran, 2);
+    BOOST_CHECK_EQUAL(ctx.late, 2);
+    BOOST_CHECK_EQUAL(stats.callbacks, 2U);
+    BOOST_CHECK_EQUAL(stats.pending, 1U);
+    BOOST_CHECK(!stats.exhausted);
+}
+
+BOOST_AUTO_TEST_CASE(iterate_time_slice) // NOLINT
+{
+    SimulatedReactor reactor;
+    auto* preactor = &reactor;
+    int ran = 0;
+    auto* pran = &ran;
+
+    for (int i = 0; i < 20; ++i) {
+        reactor.immediate([preactor, pran]() {
+            preactor->shift(1);
+            ++(*pran);
+        });
+    }
+
+    IAsyncTool::CycleStats stats;
+    reactor.iterate(
+            IAsyncTool::CycleBudget(100, std::chrono::microseconds(5000)),
+            &stats);
+
+    BOOST_CHECK_EQUAL(ran, 5);
+    BOOST_CHECK_EQUAL(stats.callbacks, 5U);
+    BOOST_CHECK_EQUAL(stats.pending, 15U);
+    BOOST_CHECK_EQUAL(stats.elapsed.count(), 5000);
+    BOOST_CHECK(stats.exhausted);
+}
+
+BOOST_AUTO_TEST_CASE(handles) // NOLINT
+{
+    Reactor reactor;
+    int count = 0;
+
+    auto h1 = reactor.immediate([&]() { ++count; });
+    auto h2 = reactor.immediate([&]() { count += 10; });
+    auto h3 = reactor.deferred(milliseconds(1), [&]() { count += 100; });
+
+    BOOST_CHECK(h1);
+    BOOST_CHECK(h2);
+    BOOST_CHECK(h3);
+
+    h2.cancel();
+    BOOST_CHECK(!h2);
+    h3.cancel();
+    BOOST_CHECK(!h3);
+    BOOST_CHECK_EQUAL(reactor.deferred_count(), 0U);
+
+    reactor.run();
+    BOOST_CHECK_EQUAL(count, 1);
+    BOOST_CHECK(!h1);
+
+    // Stale handle must not affect reused slot
+    IAsyncTool::Handle stale{std::move(h1)};
+    auto h4 = reactor.immediate([&]() { ++count; });
+    BOOST_CHECK(!stale);
+    stale.cancel();
+    BOOST_CHECK(h4);
+
+    reactor.run();
+    BOOST_CHECK_EQUAL(count, 2);
+}
+
+BOOST_AUTO_TEST_CASE(handle_generation) // NOLINT
+{
+    struct CountingReactor : Reactor
+    {
+        void cancel(Handle& h) noexcept override
+        {
+            ++cancels;
+            Reactor::cancel(h);
+        }
+
+        int cancels{0};
+    } reactor;
+
+    struct Context
+    {
+        IAsyncTool::Handle self;
+        bool valid_inside{true};
+    } ctx;
+
+    auto* pctx = &ctx;
+    ctx.self = reactor.immediate(
+            [pctx]() { pctx->valid_inside = static_cast<bool>(pctx->self); });
+
+    // Binary round-trip
+    auto bin = ctx.self.binary();
+    IAsyncTool::Handle copy{bin};
+    BOOST_CHECK(copy);
+
+    reactor.iterate();
+    BOOST_CHECK(!ctx.valid_inside);
+    BOOST_CHECK(!ctx.self);
+    BOOST_CHECK(!copy);
+
+    // Stale handles do not dispatch
+    ctx.self.cancel();
+    copy.cancel();
+    BOOST_CHECK_EQUAL(reactor.cancels, 0);
+
+    auto h = reactor.deferred(milliseconds(100), []() {});
+    h.cancel();
+    h.cancel();
+    BOOST_CHECK_EQUAL(reactor.cancels, 1);
+}
+
+BOOST_AUTO_TEST_CASE(cross_thread) // NOLINT
+{
+    Reactor reactor;
+
+    const int producers = 4;
+    const int count = 10000;
+
+    struct Context
+    {
+        std::vector<int> last;
+        int total{0};
+        bool ordered{true};
+        bool same_thread{true};
+        Reactor* reactor;
+    } ctx;
+
+    ctx.last.resize(producers, -1);
+    ctx.reactor = &reactor;
+
+    struct Post
+    {
+        Context* ctx;
+        int producer;
+        int seq;
+
+        void operator()() const
+        {
+            auto& last = ctx->last[producer];
+            ctx->ordered = ctx->ordered && (last + 1 == seq);
+            ctx->same_thread =
+                    ctx->same_thread && ctx->reactor->is_same_thread();
+            last = seq;
+            ++(ctx->total);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    std::atomic<int> handles{0};
+
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&reactor, &ctx, &handles, p]() {
+            for (int i = 0; i < count; ++i) {
+                if (reactor.immediate(Post{&ctx, p, i})) {
+                    ++handles;
+                }
+            }
+        });
+    }
+
+    auto* pctx = &ctx;
+    std::thread deferred_thread([&reactor, pctx]() {
+        reactor.deferred(milliseconds(1), [pctx]() { ++(pctx->total); });
+    });
+
+    while (ctx.total < producers * count + 1) {
+        reactor.iterate();
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    deferred_thread.join();
+
+    BOOST_CHECK(ctx.ordered);
+    BOOST_CHECK(ctx.same_thread);
+    BOOST_CHECK_EQUAL(handles.load(), 0);
+    BOOST_CHECK(!reactor.iterate().have_work);
+
+    // Not drained posts are released
+    std::thread([&reactor, pctx]() {
+        reactor.immediate([pctx]() { ++(pctx->total); });
+    }).join();
+}
+
+BOOST_AUTO_TEST_CASE(cross_thread_wakeup) // NOLINT
+{
+    Reactor reactor;
+
+    struct Context
+    {
+        IAsyncTool::Handle timer;
+    } ctx;
+
+    auto* pctx = &ctx;
+    ctx.timer = reactor.deferred(milliseconds(60000), []() {});
+
+    auto started = std::chrono::steady_clock::now();
+    std::thread poster([&reactor, pctx]() {
+        std::this_thread::sleep_for(milliseconds(20));
+        reactor.immediate([pctx]() { pctx->timer.cancel(); });
+    });
+
+    reactor.run();
+    poster.join();
+
+    BOOST_CHECK(
+            std::chrono::steady_clock::now() - started
+            < std::chrono::seconds(10));
+}
+
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE(external_loop) // NOLINT
+{
+    Reactor reactor;
+    const int fd = reactor.wakeup_fd();
+    BOOST_REQUIRE_GE(fd, 0);
+
+    using Clock = std::chrono::steady_clock;
+    int count = 0;
+    auto* pcount = &count;
+
+    BOOST_CHECK(reactor.next_deadline() == Clock::time_point::max());
+    reactor.deferred(milliseconds(30), [pcount]() { ++(*pcount); });
+    reactor.iterate();
+
+    auto deadline = reactor.next_deadline();
+    BOOST_CHECK(deadline > Clock::now());
+    BOOST_CHECK(deadline <= Clock::now() + milliseconds(31));
+
+    // Nothing to report yet
+    pollfd pfd{fd, POLLIN, 0};
+    BOOST_CHECK_EQUAL(::poll(&pfd, 1, 0), 0);
+
+    std::thread poster([&reactor, pcount]() {
+        std::this_thread::sleep_for(milliseconds(10));
+        reactor.immediate([pcount]() { ++(*pcount); });
+    });
+
+    int loops = 0;
+
+    while (count < 2) {
+        auto left = reactor.next_deadline() - Clock::now();
+        auto ms = std::chrono::duration_cast<milliseconds>(left);
+
+        if (ms < left) {
+            ms += milliseconds(1);
+        }
+
+        ::poll(&pfd, 1, static_cast<int>(std::max<long>(ms.count(), 0)));
+        reactor.iterate();
+        ++loops;
+    }
+
+    poster.join();
+
+    // One wakeup for the post and one for the timer, no busy polling
+    BOOST_CHECK_LE(loops, 4);
+    BOOST_CHECK_EQUAL(::poll(&pfd, 1, 0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(wakeup_stress) // NOLINT
+{
+    Reactor reactor;
+    const int fd = reactor.wakeup_fd();
+    BOOST_REQUIRE_GE(fd, 0);
+
+    const int rounds = 1000;
+    const int per_round = 4;
+
+    struct Context
+    {
+        std::atomic<int> done{0};
+        std::atomic<int> posted{0};
+        std::atomic<int> checked{0};
+    } ctx;
+
+    auto* pctx = &ctx;
+
+    std::thread producer([&reactor, pctx, rounds, per_round]() {
+        for (int r = 0; r < rounds; ++r) {
+            while (pctx->checked.load() < r) {
+                std::this_thread::yield();
+            }
+
+            for (int i = 0; i < per_round; ++i) {
+                reactor.immediate([pctx]() { ++(pctx->done); });
+            }
+
+            pctx->posted.store(r + 1);
+        }
+    });
+
+    IAsyncTool::CycleBudget budget;
+    budget.max_callbacks = 3;
+    pollfd pfd{fd, POLLIN, 0};
+    int stuck = 0;
+
+    for (int r = 0; r < rounds; ++r) {
+        while ((ctx.posted.load() <= r)
+               || (ctx.done.load() < (r + 1) * per_round)) {
+            reactor.iterate(budget);
+            std::this_thread::yield();
+        }
+
+        // All signals of the round are consumed by the next drain
+        reactor.iterate();
+
+        if (::poll(&pfd, 1, 0) != 0) {
+            ++stuck;
+        }
+
+        ctx.checked.store(r + 1);
+    }
+
+    producer.join();
+
+    BOOST_CHECK_EQUAL(ctx.done.load(), rounds * per_round);
+    BOOST_CHECK_EQUAL(stuck, 0);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(deferred_order) // NOLINT
+{
+    Reactor reactor;
+    std::vector<int> order;
+
+    reactor.deferred(milliseconds(30), [&]() { order.push_back(30); });
+    reactor.deferred(milliseconds(10), [&]() { order.push_back(10); });
+    reactor.deferred(milliseconds(20), [&]() { order.push_back(20); });
+    reactor.deferred(milliseconds(0), [&]() { order.push_back(0); });
+
+    auto res = reactor.iterate();
+    BOOST_CHECK(res.have_work);
+    BOOST_CHECK(res.delay.count() <= 10);
+
+    reactor.run();
+    BOOST_CHECK((order == std::vector<int>{0, 10, 20, 30}));
+}
+
+BOOST_AUTO_TEST_CASE(deferred_wheel) // NOLINT
+{
+    // Simulated time, so slow builds do not skew the deadlines
+    struct Context
+    {
+        long offset{0};
+        int fired{0};
+        long last{-1};
+        bool early{false};
+        bool late{false};
+        bool unordered{false};
+
+        void check(long delay)
+        {
+            early = early || (offset < delay);
+            // Rounded up to the next tick
+            late = late || (offset > delay + 1);
+            unordered = unordered || (delay < last);
+            last = delay;
+            ++fired;
+        }
+    };
+
+    SimulatedReactor reactor;
+    const int count = 1000;
+    std::vector<IAsyncTool::Handle> handles;
+    Context ctx;
+    auto* pctx = &ctx;
+
+    std::srand(1);
+
+    for (int i = 0; i < count; ++i) {
+        long delay = std::rand() % 600;
+
+        handles.emplace_back(reactor.deferred(
+                milliseconds(delay), [pctx, delay]() { pctx->check(delay); }));
+    }
+
+    for (int i = 0; i < count; i += 2) {
+        handles[i].cancel();
+    }
+
+    BOOST_CHECK_EQUAL(reactor.deferred_count(), std::size_t(count / 2));
+
+    while (reactor.deferred_count() > 0) {
+        ++ctx.offset;
+        reactor.shift(1);
+        reactor.iterate();
+    }
+
+    BOOST_CHECK_EQUAL(ctx.fired, count / 2);
+    BOOST_CHECK(!ctx.early);
+    BOOST_CHECK(!ctx.late);
+    BOOST_CHECK(!ctx.unordered);
+}
+
+BOOST_AUTO_TEST_CASE(deferred_beyond_wheel) // NOLINT
+{
+    constexpr Reactor::Tick SPAN = Reactor::Tick(1)
+                                   << (Reactor::WHEEL_BITS
+                                       * Reactor::WHEEL_LEVELS);
+    constexpr Reactor::Tick DELAY = SPAN + SPAN / 2;
+
+    SimulatedReactor reactor;
+    int fired = 0;
+
+    reactor.deferred(milliseconds(DELAY), [&fired]() { ++fired; });
+
+    // Past the clamped deadline of the wheel span
+    reactor.shift(SPAN + 1000);
+    reactor.iterate();
+    BOOST_CHECK_EQUAL(fired, 0);
+    BOOST_CHECK_EQUAL(reactor.deferred_count(), 1U);
+
+    reactor.shift(DELAY - SPAN - 1001);
+    reactor.iterate();
+    BOOST_CHECK_EQUAL(fired, 0);
+
+    // Rounded up to the next tick
+    reactor.shift(2);
+    reactor.iterate();
+    BOOST_CHECK_EQUAL(fired, 1);
+    BOOST_CHECK_EQUAL(reactor.deferred_count(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(deferred_delay) // NOLINT
+{
+    Reactor reactor;
+
+    reactor.deferred(milliseconds(50), []() {});
+
+    auto res = reactor.iterate();
+    BOOST_CHECK(res.have_work);
+    BOOST_CHECK(res.delay.count() > 0);
+    // Rounded up to the next tick
+    BOOST_CHECK(res.delay.count() <= 51);
+}
+
+BOOST_AUTO_TEST_CASE(timer_slack) // NOLINT
+{
+    SimulatedReactor reactor;
+    reactor.set_timer_slack(milliseconds(16));
+    BOOST_CHECK_EQUAL(reactor.timer_slack().count(), 16);
+
+    struct Context
+    {
+        Reactor::Tick offset{0};
+        std::vector<Reactor::Tick> fired;
+    } ctx;
+
+    const Reactor::Tick count = 200;
+    std::vector<IAsyncTool::Handle> handles;
+    ctx.fired.resize(count, 0);
+
+    for (Reactor::Tick i = 0; i < count; ++i) {
+        auto* pctx = &ctx;
+        handles.emplace_back(reactor.deferred(
+                milliseconds(100 + i),
+                [pctx, i]() { pctx->fired[i] = pctx->offset; }));
+    }
+
+    // Cancel is still an O(1) unlink
+    for (Reactor::Tick i = 0; i < count; i += 2) {
+        handles[i].cancel();
+    }
+
+    std::size_t wakeups = 0;
+
+    while (reactor.deferred_count() > 0) {
+        ++ctx.offset;
+        reactor.shift(1);
+
+        IAsyncTool::CycleStats stats;
+        reactor.iterate(IAsyncTool::CycleBudget(), &stats);
+
+        if (stats.expired > 0) {
+            ++wakeups;
+        }
+    }
+
+    for (Reactor::Tick i = 1; i < count; i += 2) {
+        BOOST_CHECK_GE(ctx.fired[i], 100 + i);
+        BOOST_CHECK_LE(ctx.fired[i], 100 + i + 16);
+    }
+
+    BOOST_CHECK_LE(wakeups, count / 16 + 2);
+
+    // Short delays are not coalesced
+    ctx.fired[0] = 0;
+    auto* pctx = &ctx;
+    reactor.deferred(milliseconds(3), [pctx]() { pctx->fired[0] = 1; });
+    reactor.shift(4);
+    reactor.iterate();
+    BOOST_CHECK_EQUAL(ctx.fired[0], 1U);
+}
+
+BOOST_AUTO_TEST_CASE(deferred_cascade) // NOLINT
+{
+    SimulatedReactor reactor;
+
+    const std::vector<Reactor::Tick> delays{
+            1,
+            255,
+            256,
+            257,
+            65535,
+            65536,
+            70000,
+            (Reactor::Tick(1) << 24U) + 5,
+            3000000000ULL};
+
+    struct Context
+    {
+        Reactor::Tick offset{0};
+        std::vector<Reactor::Tick> fired;
+    } ctx;
+
+    ctx.fired.resize(delays.size(), 0);
+
+    for (std::size_t i = 0; i < delays.size(); ++i) {
+        auto* pctx = &ctx;
+        reactor.deferred(milliseconds(delays[i]), [pctx, i]() {
+            pctx->fired[i] = pctx->offset;
+        });
+    }
+
+    Reactor::Tick prev = 0;
+
+    while (reactor.deferred_count() > 0 || reactor.immediate_count() > 0) {
+        auto step = 1 + ctx.offset / 1000;
+        prev = ctx.offset;
+        ctx.offset += step;
+        reactor.shift(step);
+        reactor.iterate();
+
+        for (std::size_t i = 0; i < delays.size(); ++i) {
+            if (ctx.fired[i] == ctx.offset) {
+                // Never early, at most one tick late due to rounding
+                BOOST_CHECK_GE(ctx.fired[i], delays[i]);
+                BOOST_CHECK_LT(prev, delays[i] + 1);
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < delays.size(); ++i) {
+        BOOST_CHECK_GE(ctx.fired[i], delays[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(deferred_next_wakeup) // NOLINT
+{
+    SimulatedReactor reactor;
+
+    // Upper wheel levels, two in the same bucket
+    const std::vector<Reactor::Tick> delays{300, 290, 1000, 70000};
+
+    struct Context
+    {
+        Reactor::Tick offset{0};
+        std::vector<Reactor::Tick> fired;
+    } ctx;
+
+    ctx.fired.resize(delays.size(), 0);
+
+    for (std::size_t i = 0; i < delays.size(); ++i) {
+        auto* pctx = &ctx;
+        reactor.deferred(milliseconds(delays[i]), [pctx, i]() {
+            pctx->fired[i] = pctx->offset;
+        });
+    }
+
+    std::size_t empty_wakeups = 0;
+    auto res = reactor.iterate();
+
+    // Earliest expiry, not the cascade tick
+    BOOST_CHECK_GE(res.delay.count(), 290);
+    BOOST_CHECK_LE(res.delay.count(), 291);
+
+    while (reactor.deferred_count() > 0) {
+        BOOST_REQUIRE(res.have_work);
+        ctx.offset += static_cast<Reactor::Tick>(res.delay.count());
+        reactor.shift(static_cast<Reactor::Tick>(res.delay.count()));
+
+        IAsyncTool::CycleStats stats;
+        res = reactor.iterate(IAsyncTool::CycleBudget(), &stats);
+
+        if (stats.expired == 0) {
+            ++empty_wakeups;
+        }
+    }
+
+    BOOST_CHECK_EQUAL(empty_wakeups, 0U);
+
+    for (std::size_t i = 0; i < delays.size(); ++i) {
+        BOOST_CHECK_GE(ctx.fired[i], delays[i]);
+        BOOST_CHECK_LE(ctx.fired[i], delays[i] + 1);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // NOLINT
@@ -0,0 +1,255 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <futoin/ri/asyncsteps.hpp>
+#include <futoin/ri/reactorpool.hpp>
+
+using futoin::IAsyncSteps;
+using futoin::IAsyncTool;
+using futoin::ri::ReactorPool;
+using std::chrono::milliseconds;
+
+namespace {
+    template<typename Pred>
+    bool wait_for(Pred pred)
+    {
+        auto deadline = std::chrono::steady_clock::now() + milliseconds(10000);
+
+        while (!pred()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+
+            std::this_thread::sleep_for(milliseconds(1));
+        }
+
+        return true;
+    }
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(reactorpool) // NOLINT
+
+BOOST_AUTO_TEST_CASE(jobs) // NOLINT
+{
+    ReactorPool pool(4);
+    BOOST_CHECK_EQUAL(pool.size(), 4U);
+
+    std::atomic<int> done{0};
+    std::atomic<int> same_thread{0};
+
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit([&](IAsyncTool& tool) {
+            if (tool.is_same_thread()) {
+                ++same_thread;
+            }
+
+            ++done;
+        });
+    }
+
+    BOOST_CHECK(wait_for([&]() { return done == 1000; }));
+    BOOST_CHECK_EQUAL(same_thread.load(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(nested) // NOLINT
+{
+    ReactorPool pool(2);
+
+    std::atomic<int> done{0};
+    auto* pdone = &done;
+
+    pool.submit([&pool, pdone](IAsyncTool& tool) {
+        tool.immediate([pdone]() { ++(*pdone); });
+        tool.deferred(milliseconds(5), [pdone]() { ++(*pdone); });
+
+        for (int i = 0; i < 10; ++i) {
+            pool.submit([pdone](IAsyncTool&) { ++(*pdone); });
+        }
+    });
+
+    BOOST_CHECK(wait_for([&]() { return done == 12; }));
+}
+
+BOOST_AUTO_TEST_CASE(steal) // NOLINT
+{
+    ReactorPool pool(4);
+
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int> done{0};
+
+    for (int i = 0; i < 64; ++i) {
+        pool.submit_to(0, [&](IAsyncTool&) {
+            std::this_thread::sleep_for(milliseconds(1));
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                threads.insert(std::this_thread::get_id());
+            }
+
+            ++done;
+        });
+    }
+
+    BOOST_CHECK(wait_for([&]() { return done == 64; }));
+    BOOST_CHECK_GT(pool.steal_count(), 0U);
+    BOOST_CHECK_GT(threads.size(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(foreign_post) // NOLINT
+{
+    ReactorPool pool(2);
+
+    std::atomic<int> done{0};
+    std::atomic<IAsyncTool*> tool_ptr{nullptr};
+    auto* pdone = &done;
+
+    pool.submit([&tool_ptr](IAsyncTool& tool) { tool_ptr = &tool; });
+    BOOST_REQUIRE(wait_for([&]() { return tool_ptr != nullptr; }));
+
+    // Idle worker is woken by the reactor inbox
+    std::this_thread::sleep_for(milliseconds(10));
+    tool_ptr.load()->immediate([pdone]() { ++(*pdone); });
+    tool_ptr.load()->deferred(milliseconds(5), [pdone]() { ++(*pdone); });
+
+    BOOST_CHECK(wait_for([&]() { return done == 2; }));
+}
+
+BOOST_AUTO_TEST_CASE(stop) // NOLINT
+{
+    ReactorPool pool(2);
+    std::atomic<bool> started{false};
+    std::atomic<bool> finished{false};
+    std::atomic<int> done{0};
+
+    pool.submit_to(0, [&](IAsyncTool&) {
+        started = true;
+        std::this_thread::sleep_for(milliseconds(50));
+        finished = true;
+    });
+    BOOST_REQUIRE(wait_for([&]() { return started.load(); }));
+
+    for (int i = 0; i < 100; ++i) {
+        pool.submit([&](IAsyncTool&) { ++done; });
+    }
+
+    // Running job is joined
+    pool.stop();
+    BOOST_CHECK(finished.load());
+
+    const int stopped = done.load();
+    pool.stop();
+
+    pool.submit([&](IAsyncTool&) { ++done; });
+    pool.submit_to(1, [&](IAsyncTool&) { ++done; });
+    std::this_thread::sleep_for(milliseconds(20));
+    BOOST_CHECK_EQUAL(done.load(), stopped);
+}
+
+BOOST_AUTO_TEST_CASE(steps) // NOLINT
+{
+    ReactorPool pool(2, [](IAsyncTool& tool) {
+        return std::unique_ptr<IAsyncSteps>(new futoin::ri::AsyncSteps(tool));
+    });
+    std::atomic<int> done{0};
+
+    for (int i = 0; i < 100; ++i) {
+        pool.submit_steps([&](IAsyncSteps& asi) {
+            asi.add([](IAsyncSteps& asi) { asi(1); });
+            asi.add([&](IAsyncSteps& asi, int v) {
+                asi.add([&, v](IAsyncSteps&) { done += v; });
+            });
+        });
+    }
+
+    BOOST_CHECK(wait_for([&]() { return done == 100; }));
+}
+
+BOOST_AUTO_TEST_CASE(steps_release) // NOLINT
+{
+    struct CountedSteps : futoin::ri::AsyncSteps
+    {
+        CountedSteps(IAsyncTool& tool, std::atomic<int>& live) :
+            AsyncSteps(tool), live(live)
+        {
+            ++live;
+        }
+
+        ~CountedSteps() noexcept override
+        {
+            --live;
+        }
+
+        std::unique_ptr<IAsyncSteps> newInstance() noexcept override
+        {
+            return std::unique_ptr<IAsyncSteps>(
+                    new CountedSteps(tool(), live));
+        }
+
+        std::atomic<int>& live;
+    };
+
+    std::atomic<int> live{0};
+    std::atomic<int> handled{0};
+    ReactorPool pool(2, [&live](IAsyncTool& tool) {
+        return std::unique_ptr<IAsyncSteps>(new CountedSteps(tool, live));
+    });
+
+    BOOST_CHECK_EQUAL(live.load(), 2);
+
+    for (int i = 0; i < 10; ++i) {
+        pool.submit_steps([&](IAsyncSteps& asi) {
+            // Own handler does not prevent release
+            asi.state().set_unhandled_error(
+                    [&](futoin::ErrorCode /*code*/) { ++handled; });
+            asi.add([](IAsyncSteps& asi) { asi.error("Failed"); });
+        });
+    }
+
+    // Without own handler
+    pool.submit_steps([](IAsyncSteps& asi) {
+        asi.add([](IAsyncSteps& asi) { asi.error("Failed"); });
+    });
+
+    // Handler replaced by a step
+    pool.submit_steps([&](IAsyncSteps& asi) {
+        asi.add([&](IAsyncSteps& asi) {
+            asi.state().set_unhandled_error(
+                    [&](futoin::ErrorCode /*code*/) { ++handled; });
+            asi.error("Failed");
+        });
+    });
+
+    // Canceled
+    pool.submit_steps([](IAsyncSteps& asi) {
+        auto* root = &asi;
+        asi.add([](IAsyncSteps& asi) { asi.waitExternal(); });
+        asi.tool().deferred(milliseconds(1), [root]() { root->cancel(); });
+    });
+
+    BOOST_CHECK(wait_for([&]() { return handled == 11 && live == 2; }));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // NOLINT
@@ -0,0 +1,201 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <futoin/ri/slabmempool.hpp>
+#include <futoin/string.hpp>
+
+using futoin::IMemPool;
+using futoin::ri::SlabMemPool;
+
+BOOST_AUTO_TEST_SUITE(slabmempool) // NOLINT
+
+BOOST_AUTO_TEST_CASE(reuse) // NOLINT
+{
+    SlabMemPool pool;
+
+    auto* p1 = pool.allocate(24, 1);
+    auto* p2 = pool.allocate(24, 1);
+    BOOST_CHECK(p1 != nullptr);
+    BOOST_CHECK(p2 != nullptr);
+    BOOST_CHECK(p1 != p2);
+
+    pool.deallocate(p2, 24, 1);
+    BOOST_CHECK_EQUAL(pool.allocate(24, 1), p2);
+
+    // Same size class
+    pool.deallocate(p1, 24, 1);
+    BOOST_CHECK_EQUAL(pool.allocate(32, 1), p1);
+}
+
+BOOST_AUTO_TEST_CASE(size_classes) // NOLINT
+{
+    SlabMemPool pool;
+    std::vector<void*> ptrs;
+
+    for (std::size_t size = 1; size <= SlabMemPool::MAX_OBJECT_SIZE * 2;
+         size += 7) {
+        auto* p = reinterpret_cast<char*>(pool.allocate(size, 1));
+        BOOST_CHECK_EQUAL(
+                reinterpret_cast<std::uintptr_t>(p) % SlabMemPool::GRANULARITY,
+                0U);
+        std::fill(p, p + size, 'x');
+        ptrs.push_back(p);
+    }
+
+    std::size_t size = 1;
+
+    for (auto* p : ptrs) {
+        pool.deallocate(p, size, 1);
+        size += 7;
+    }
+
+    pool.release_memory();
+}
+
+BOOST_AUTO_TEST_CASE(optimized) // NOLINT
+{
+    SlabMemPool pool;
+
+    auto& sub = pool.mem_pool(sizeof(double), true);
+    BOOST_CHECK(&sub != &pool);
+    BOOST_CHECK_EQUAL(&pool.mem_pool(sizeof(double)), &pool);
+    BOOST_CHECK_EQUAL(&sub.mem_pool(sizeof(double), true), &sub);
+    BOOST_CHECK_EQUAL(&pool.mem_pool(SlabMemPool::MAX_OBJECT_SIZE + 1), &pool);
+
+    auto* p = sub.allocate(sizeof(double), 1);
+    sub.deallocate(p, sizeof(double), 1);
+    BOOST_CHECK_EQUAL(pool.allocate(sizeof(double), 1), p);
+    pool.deallocate(p, sizeof(double), 1);
+
+    // Fallback of non-matching size to parent
+    auto* p2 = sub.allocate(sizeof(double), 100);
+    sub.deallocate(p2, sizeof(double), 100);
+}
+
+BOOST_AUTO_TEST_CASE(thread_default) // NOLINT
+{
+    using IntAllocator = IMemPool::Allocator<int>;
+    using CharAllocator = IMemPool::Allocator<char>;
+
+    SlabMemPool pool;
+    int* data = nullptr;
+
+    // Allocators cache the default pool per type and thread
+    IntAllocator::reset_thread_default();
+    CharAllocator::reset_thread_default();
+    futoin::GlobalMemPool::set_thread_default(pool);
+
+    {
+        std::vector<int, IntAllocator> v;
+        v.reserve(4);
+
+        for (int i = 0; i < 4; ++i) {
+            v.push_back(i);
+        }
+
+        data = v.data();
+        BOOST_CHECK_EQUAL(v[3], 3);
+
+        futoin::string s{"Some long string to avoid small string optimization"};
+        s += s;
+    }
+
+    // Returned to the slab
+    auto* p = pool.allocate(sizeof(int), 4);
+    BOOST_CHECK_EQUAL(p, data);
+    pool.deallocate(p, sizeof(int), 4);
+
+    // Must not refer to the pool after it's gone
+    IntAllocator::reset_thread_default();
+    CharAllocator::reset_thread_default();
+    futoin::GlobalMemPool::reset_thread_default();
+}
+
+BOOST_AUTO_TEST_CASE(remote_free) // NOLINT
+{
+    SlabMemPool pool;
+    const std::size_t count = 1000;
+    std::vector<void*> ptrs;
+
+    auto* keep = pool.allocate(48, 1);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        ptrs.push_back(pool.allocate(48, 1));
+    }
+
+    auto& sub = pool.mem_pool(48, true);
+    ptrs.push_back(sub.allocate(48, 1));
+
+    std::thread([&]() {
+        BOOST_CHECK(!pool.is_owner_thread());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            pool.deallocate(ptrs[i], 48, 1);
+        }
+
+        sub.deallocate(ptrs.back(), 48, 1);
+    }).join();
+
+    // Remote queue is drained, but the chunk is still in use
+    pool.release_memory();
+
+    auto* p = pool.allocate(48, 1);
+    BOOST_CHECK(std::find(ptrs.begin(), ptrs.end(), p) != ptrs.end());
+    pool.deallocate(p, 48, 1);
+    pool.deallocate(keep, 48, 1);
+    pool.release_memory();
+}
+
+BOOST_AUTO_TEST_CASE(remote_free_concurrent) // NOLINT
+{
+    SlabMemPool pool;
+    const std::size_t count = 10000;
+    std::vector<void*> ptrs;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        ptrs.push_back(pool.allocate(16, 1));
+    }
+
+    std::thread t1([&]() {
+        for (std::size_t i = 0; i < count; i += 2) {
+            pool.deallocate(ptrs[i], 16, 1);
+        }
+    });
+    std::thread t2([&]() {
+        for (std::size_t i = 1; i < count; i += 2) {
+            pool.deallocate(ptrs[i], 16, 1);
+        }
+    });
+
+    // Owner keeps allocating meanwhile
+    for (std::size_t i = 0; i < count; ++i) {
+        pool.deallocate(pool.allocate(16, 1), 16, 1);
+    }
+
+    t1.join();
+    t2.join();
+    pool.release_memory();
+}
+
+BOOST_AUTO_TEST_SUITE_END() // NOLINT
@@ -0,0 +1,159 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <futoin/ri/slabmempool.hpp>
+#include <futoin/ri/steparena.hpp>
+
+using futoin::ri::StepArena;
+
+namespace {
+    std::vector<int> destroy_order; // NOLINT
+
+    struct Tracked
+    {
+        Tracked(int id) : id(id) {}
+        ~Tracked()
+        {
+            destroy_order.push_back(id);
+        }
+
+        int id;
+    };
+
+    template<typename T, typename... Args>
+    T& make(StepArena& arena, Args&&... args)
+    {
+        void* ptr = arena.allocate(
+                sizeof(T), [](void* ptr) { reinterpret_cast<T*>(ptr)->~T(); });
+        return *(new (ptr) T(std::forward<Args>(args)...));
+    }
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(steparena) // NOLINT
+
+BOOST_AUTO_TEST_CASE(bump) // NOLINT
+{
+    StepArena arena;
+
+    const std::size_t alignment = StepArena::ALIGNMENT;
+    auto* p1 = reinterpret_cast<char*>(arena.allocate(1));
+    auto* p2 = reinterpret_cast<char*>(arena.allocate(1));
+    BOOST_CHECK_EQUAL(std::size_t(p2 - p1), alignment);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(p1) % alignment, 0U);
+
+    // Reused after release
+    arena.release();
+    BOOST_CHECK_EQUAL(arena.allocate(1), p1);
+}
+
+BOOST_AUTO_TEST_CASE(destroy_reverse) // NOLINT
+{
+    destroy_order.clear();
+
+    {
+        StepArena arena;
+
+        make<Tracked>(arena, 1);
+        arena.allocate(sizeof(int), &futoin::asyncsteps::default_destroy_cb);
+        make<Tracked>(arena, 2);
+        make<Tracked>(arena, 3);
+
+        arena.release();
+        BOOST_CHECK((destroy_order == std::vector<int>{3, 2, 1}));
+
+        make<Tracked>(arena, 4);
+    }
+
+    BOOST_CHECK((destroy_order == std::vector<int>{3, 2, 1, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(large) // NOLINT
+{
+    futoin::ri::SlabMemPool pool;
+    StepArena arena(pool);
+
+    for (int i = 0; i < 100; ++i) {
+        auto* p = reinterpret_cast<char*>(arena.allocate(100));
+        std::fill(p, p + 100, 'x');
+    }
+
+    auto* big = reinterpret_cast<char*>(
+            arena.allocate(StepArena::DEFAULT_BLOCK_SIZE * 4));
+    std::fill(big, big + StepArena::DEFAULT_BLOCK_SIZE * 4, 'x');
+
+    arena.release();
+    arena.allocate(10);
+    arena.release_memory();
+    pool.release_memory();
+}
+
+BOOST_AUTO_TEST_CASE(release_oversized) // NOLINT
+{
+    struct CountingMemPool : futoin::IMemPool
+    {
+        void* allocate(size_t object_size, size_t count) noexcept override
+        {
+            ++live;
+            return parent.allocate(object_size, count);
+        }
+
+        void deallocate(
+                void* ptr, size_t object_size, size_t count) noexcept override
+        {
+            --live;
+            parent.deallocate(ptr, object_size, count);
+        }
+
+        void release_memory() noexcept override {}
+
+        futoin::IMemPool& parent{futoin::GlobalMemPool::get_default()};
+        int live{0};
+    } pool;
+
+    {
+        StepArena arena(pool);
+
+        auto* p1 = arena.allocate(10);
+        arena.allocate(StepArena::DEFAULT_BLOCK_SIZE * 4);
+        BOOST_CHECK_EQUAL(pool.live, 2);
+
+        // Only the regular first block is kept
+        arena.release();
+        BOOST_CHECK_EQUAL(pool.live, 1);
+        BOOST_CHECK_EQUAL(arena.allocate(10), p1);
+
+        // Oversized first block is not kept
+        arena.release_memory();
+        arena.allocate(StepArena::DEFAULT_BLOCK_SIZE * 4);
+        BOOST_CHECK_EQUAL(pool.live, 1);
+        arena.release();
+        BOOST_CHECK_EQUAL(pool.live, 0);
+
+        arena.allocate(10);
+        BOOST_CHECK_EQUAL(pool.live, 1);
+    }
+
+    BOOST_CHECK_EQUAL(pool.live, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // NOLINT
@@ -0,0 +1,547 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 FutoIn Project (https://futoin.org)
+// Copyright 2026 Andrey Galkin <andrey@futoin.org>
+//
+// Licensed under the FutoIn Public License 1.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://specs.futoin.org/LICENSE.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//-----------------------------------------------------------------------------
+
+#include <boost/test/unit_test.hpp>
+
+#include <futoin/ri/asyncsteps.hpp>
+#include <futoin/ri/uringreactor.hpp>
+
+#ifdef FUTOIN_RI_URING
+
+#    include <algorithm>
+#    include <array>
+#    include <cerrno>
+#    include <chrono>
+#    include <cstring>
+#    include <iterator>
+#    include <string>
+#    include <thread>
+
+#    include <fcntl.h>
+#    include <netinet/in.h>
+#    include <poll.h>
+#    include <sys/mman.h>
+#    include <sys/socket.h>
+#    include <unistd.h>
+
+using futoin::ErrorCode;
+using futoin::IAsyncSteps;
+using futoin::IAsyncTool;
+using futoin::ri::AsyncSteps;
+using futoin::ri::UringReactor;
+using std::chrono::milliseconds;
+
+BOOST_AUTO_TEST_SUITE(uringreactor) // NOLINT
+
+BOOST_AUTO_TEST_CASE(timers) // NOLINT
+{
+    UringReactor reactor;
+
+    if (!reactor.uring_active()) {
+        BOOST_TEST_MESSAGE("io_uring is not available");
+    }
+
+    int count = 0;
+    auto started = std::chrono::steady_clock::now();
+
+    reactor.immediate([&count]() { ++count; });
+    reactor.deferred(milliseconds(20), [&count]() { count += 10; });
+    auto h = reactor.deferred(milliseconds(10), [&count]() { count += 100; });
+    h.cancel();
+
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(count, 11);
+    BOOST_CHECK(
+            std::chrono::steady_clock::now() - started >= milliseconds(20));
+}
+
+BOOST_AUTO_TEST_CASE(wakeup) // NOLINT
+{
+    UringReactor reactor;
+
+    struct Context
+    {
+        IAsyncTool::Handle timer;
+    } ctx;
+
+    auto* pctx = &ctx;
+    ctx.timer = reactor.deferred(milliseconds(60000), []() {});
+
+    auto started = std::chrono::steady_clock::now();
+    std::thread poster([&reactor, pctx]() {
+        std::this_thread::sleep_for(milliseconds(20));
+        reactor.immediate([pctx]() { pctx->timer.cancel(); });
+    });
+
+    reactor.run();
+    poster.join();
+
+    BOOST_CHECK(
+            std::chrono::steady_clock::now() - started
+            < std::chrono::seconds(10));
+}
+
+BOOST_AUTO_TEST_CASE(timeout_rearm) // NOLINT
+{
+    UringReactor reactor;
+
+    if (!reactor.uring_active()) {
+        return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    auto wait_till = [&reactor](Clock::time_point end) {
+        int loops = 0;
+
+        while (Clock::now() < end) {
+            auto left = std::chrono::duration_cast<milliseconds>(
+                    end - Clock::now());
+            reactor.wait(left + milliseconds(1));
+            reactor.iterate();
+            ++loops;
+        }
+
+        return loops;
+    };
+
+    // Armed for 50 ms, but woken up earlier
+    std::thread poster([&reactor]() {
+        std::this_thread::sleep_for(milliseconds(5));
+        reactor.immediate([]() {});
+    });
+    reactor.wait(milliseconds(50));
+    poster.join();
+    reactor.iterate();
+
+    // Earlier deadline supersedes it
+    wait_till(Clock::now() + milliseconds(10));
+
+    // Removed timeout must not wake up this one
+    BOOST_CHECK_EQUAL(wait_till(Clock::now() + milliseconds(100)), 1);
+}
+
+BOOST_AUTO_TEST_CASE(external_loop) // NOLINT
+{
+    UringReactor reactor;
+    const int fd = reactor.wakeup_fd();
+    BOOST_REQUIRE_GE(fd, 0);
+
+    using Clock = std::chrono::steady_clock;
+    int count = 0;
+    auto* pcount = &count;
+
+    BOOST_CHECK(reactor.next_deadline() == Clock::time_point::max());
+    reactor.deferred(milliseconds(30), [pcount]() { ++(*pcount); });
+    reactor.iterate();
+
+    auto deadline = reactor.next_deadline();
+    BOOST_CHECK(deadline > Clock::now());
+    BOOST_CHECK(deadline <= Clock::now() + milliseconds(31));
+
+    // Nothing to report yet
+    pollfd pfd{fd, POLLIN, 0};
+    BOOST_CHECK_EQUAL(::poll(&pfd, 1, 0), 0);
+
+    std::thread poster([&reactor, pcount]() {
+        std::this_thread::sleep_for(milliseconds(10));
+        reactor.immediate([pcount]() { ++(*pcount); });
+    });
+
+    int loops = 0;
+
+    while (count < 2) {
+        auto left = reactor.next_deadline() - Clock::now();
+        auto ms = std::chrono::duration_cast<milliseconds>(left);
+
+        if (ms < left) {
+            ms += milliseconds(1);
+        }
+
+        ::poll(&pfd, 1, static_cast<int>(std::max<long>(ms.count(), 0)));
+        reactor.iterate();
+        ++loops;
+    }
+
+    poster.join();
+
+    // One wakeup for the post and one for the timer, no busy polling
+    BOOST_CHECK_LE(loops, 4);
+    BOOST_CHECK_EQUAL(::poll(&pfd, 1, 0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(pipe_io) // NOLINT
+{
+    UringReactor reactor;
+
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(::pipe(fds), 0);
+
+    struct Context
+    {
+        char buf[16]{};
+        int read_res{0};
+        int write_res{0};
+    } ctx;
+
+    auto* pctx = &ctx;
+    const auto no_offset = ~std::uint64_t(0);
+
+    reactor.read(fds[0], ctx.buf, sizeof(ctx.buf), no_offset, [pctx](int res) {
+        pctx->read_res = res;
+    });
+    reactor.write(fds[1], "hello", 5, no_offset, [pctx](int res) {
+        pctx->write_res = res;
+    });
+
+    BOOST_CHECK_EQUAL(reactor.io_count(), 2U);
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(reactor.io_count(), 0U);
+
+    if (reactor.uring_active()) {
+        BOOST_CHECK_EQUAL(ctx.write_res, 5);
+        BOOST_CHECK_EQUAL(ctx.read_res, 5);
+        BOOST_CHECK_EQUAL(std::string(ctx.buf), "hello");
+    } else {
+        BOOST_CHECK_EQUAL(ctx.read_res, -ENOSYS);
+    }
+
+    // In flight on destruction
+    ctx.read_res = 0;
+    {
+        UringReactor other;
+        other.read(
+                fds[0],
+                ctx.buf,
+                sizeof(ctx.buf),
+                no_offset,
+                [pctx](int res) { pctx->read_res = res; });
+        other.iterate();
+    }
+
+    if (reactor.uring_active()) {
+        // Canceled before return, so it does not consume later data
+        BOOST_CHECK_EQUAL(ctx.read_res, -ECANCELED);
+        BOOST_REQUIRE_EQUAL(::write(fds[1], "next", 4), 4);
+
+        char next[8]{};
+        BOOST_CHECK_EQUAL(::read(fds[0], next, sizeof(next)), 4);
+        BOOST_CHECK_EQUAL(std::string(next), "next");
+    }
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+BOOST_AUTO_TEST_CASE(large_io) // NOLINT
+{
+    UringReactor reactor;
+
+    if (!reactor.uring_active() || (sizeof(std::size_t) <= 4)) {
+        return;
+    }
+
+    // Readable zero pages, length does not fit 32 bits
+    const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const auto len = (std::size_t(1) << 32U) + page;
+    void* buf = ::mmap(
+            nullptr,
+            len,
+            PROT_READ,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+            -1,
+            0);
+
+    if (buf == MAP_FAILED) {
+        BOOST_TEST_MESSAGE("no address space for large_io");
+        return;
+    }
+
+    int fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    BOOST_REQUIRE_GE(fd, 0);
+
+    int res = 0;
+    auto* pres = &res;
+
+    reactor.write(fd, buf, len, ~std::uint64_t(0), [pres](int r) {
+        *pres = r;
+    });
+    reactor.run();
+
+    // Short write, not a truncated length
+    BOOST_CHECK_EQUAL(res, static_cast<int>(UringReactor::MAX_IO_SIZE));
+
+    ::close(fd);
+    ::munmap(buf, len);
+}
+
+BOOST_AUTO_TEST_CASE(accept) // NOLINT
+{
+    UringReactor reactor;
+
+    if (!reactor.uring_active()) {
+        return;
+    }
+
+    int srv = ::socket(AF_INET, SOCK_STREAM, 0);
+    BOOST_REQUIRE_GE(srv, 0);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+
+    BOOST_REQUIRE_EQUAL(
+            ::bind(srv, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    BOOST_REQUIRE_EQUAL(::listen(srv, 1), 0);
+    BOOST_REQUIRE_EQUAL(
+            ::getsockname(srv, reinterpret_cast<sockaddr*>(&addr), &addr_len),
+            0);
+
+    int accepted = -1;
+    reactor.accept(srv, [&accepted](int res) { accepted = res; });
+    reactor.iterate();
+
+    int client = ::socket(AF_INET, SOCK_STREAM, 0);
+    BOOST_REQUIRE_EQUAL(
+            ::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)),
+            0);
+
+    reactor.run();
+    BOOST_CHECK_GE(accepted, 0);
+
+    ::close(accepted);
+    ::close(client);
+    ::close(srv);
+}
+
+BOOST_AUTO_TEST_CASE(steps_io) // NOLINT
+{
+    UringReactor reactor;
+
+    if (!reactor.uring_active()) {
+        return;
+    }
+
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(::pipe(fds), 0);
+
+    struct Context
+    {
+        UringReactor& reactor;
+        int fds[2];
+        char buf[16];
+        std::size_t written;
+        std::size_t read;
+        futoin::string error;
+        futoin::string error_info;
+    } ctx{reactor, {fds[0], fds[1]}, {}, 0, 0, {}, {}};
+
+    auto* pctx = &ctx;
+    AsyncSteps root(reactor);
+
+    auto on_error = [pctx](IAsyncSteps& asi, ErrorCode code) {
+        pctx->error = code;
+        pctx->error_info = asi.state().error_info();
+        asi.success();
+    };
+
+    // Success
+    root.add([pctx](IAsyncSteps& asi) {
+        pctx->reactor.write(asi, pctx->fds[1], "hello", 5);
+    });
+    root.add([pctx](IAsyncSteps& asi, std::size_t res) {
+        pctx->written = res;
+        pctx->reactor.read(asi, pctx->fds[0], pctx->buf, sizeof(pctx->buf));
+    });
+    root.add([pctx](IAsyncSteps&, std::size_t res) { pctx->read = res; });
+    root.execute();
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(ctx.written, 5U);
+    BOOST_CHECK_EQUAL(ctx.read, 5U);
+    BOOST_CHECK_EQUAL(std::string(ctx.buf, 5), "hello");
+    BOOST_CHECK_EQUAL(reactor.io_count(), 0U);
+
+    // Error
+    root.add(
+            [pctx](IAsyncSteps& asi) {
+                pctx->reactor.read(asi, -1, pctx->buf, sizeof(pctx->buf));
+            },
+            on_error);
+    root.execute();
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(ctx.error, futoin::errors::CommError);
+    BOOST_CHECK_EQUAL(ctx.error_info, std::strerror(EBADF));
+    BOOST_CHECK_EQUAL(reactor.io_count(), 0U);
+
+    // Timeout cancels the read, its result is dropped
+    ctx.error.clear();
+    ctx.read = 0;
+    std::fill(std::begin(ctx.buf), std::end(ctx.buf), '\0');
+    root.add(
+            [pctx](IAsyncSteps& asi) {
+                pctx->reactor.read(
+                        asi, pctx->fds[0], pctx->buf, sizeof(pctx->buf));
+                asi.setTimeout(milliseconds(10));
+            },
+            on_error);
+    root.add([pctx](IAsyncSteps&) { pctx->read = 1; });
+    root.execute();
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(ctx.error, futoin::errors::Timeout);
+    BOOST_CHECK_EQUAL(ctx.read, 1U);
+    BOOST_CHECK_EQUAL(reactor.io_count(), 0U);
+
+    // Nothing is left to consume the data
+    BOOST_CHECK_EQUAL(::write(fds[1], "x", 1), 1);
+    char c = 0;
+    BOOST_CHECK_EQUAL(::read(fds[0], &c, 1), 1);
+    BOOST_CHECK_EQUAL(c, 'x');
+    BOOST_CHECK_EQUAL(ctx.buf[0], '\0');
+
+    // Step buffers go away on cancel, while the kernel may still use one
+    ctx.read = 0;
+    root.add([pctx](IAsyncSteps& asi) {
+        using Buf = std::array<char, 16>;
+        auto& buf = asi.stack<Buf>();
+        asi.add([pctx, &buf](IAsyncSteps& asi) {
+            pctx->reactor.read(asi, pctx->fds[0], buf.data(), buf.size());
+        });
+        asi.add([pctx, &buf](IAsyncSteps&, std::size_t res) {
+            pctx->read = res;
+            std::copy(buf.begin(), buf.begin() + res, pctx->buf);
+        });
+    });
+    root.execute();
+    reactor.iterate();
+    BOOST_CHECK_EQUAL(::write(fds[1], "stack", 5), 5);
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(ctx.read, 5U);
+    BOOST_CHECK_EQUAL(std::string(ctx.buf, 5), "stack");
+
+    ctx.read = 0;
+    root.add([pctx](IAsyncSteps& asi) {
+        auto& buf = asi.stack<std::array<char, 16>>();
+        pctx->reactor.read(asi, pctx->fds[0], buf.data(), buf.size());
+        asi.setTimeout(milliseconds(10));
+    });
+    root.state().set_unhandled_error([](ErrorCode) {});
+    root.execute();
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(ctx.read, 0U);
+    BOOST_CHECK_EQUAL(reactor.io_count(), 0U);
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+BOOST_AUTO_TEST_CASE(steps_accept) // NOLINT
+{
+    UringReactor reactor;
+
+    if (!reactor.uring_active()) {
+        return;
+    }
+
+    int srv = ::socket(AF_INET, SOCK_STREAM, 0);
+    BOOST_REQUIRE_GE(srv, 0);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+
+    BOOST_REQUIRE_EQUAL(
+            ::bind(srv, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    BOOST_REQUIRE_EQUAL(::listen(srv, 1), 0);
+    BOOST_REQUIRE_EQUAL(
+            ::getsockname(srv, reinterpret_cast<sockaddr*>(&addr), &addr_len),
+            0);
+
+    struct Context
+    {
+        UringReactor& reactor;
+        int srv;
+        int accepted;
+        futoin::string error;
+    } ctx{reactor, srv, -1, {}};
+
+    auto* pctx = &ctx;
+    AsyncSteps root(reactor);
+
+    auto on_error = [pctx](IAsyncSteps& asi, ErrorCode code) {
+        pctx->error = code;
+        asi.success();
+    };
+
+    // Timeout
+    root.add(
+            [pctx](IAsyncSteps& asi) {
+                pctx->reactor.accept(asi, pctx->srv);
+                asi.setTimeout(milliseconds(10));
+            },
+            on_error);
+    root.execute();
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(ctx.error, futoin::errors::Timeout);
+    BOOST_CHECK_EQUAL(reactor.io_count(), 0U);
+
+    // Success
+    root.add([pctx](IAsyncSteps& asi) {
+        pctx->reactor.accept(asi, pctx->srv);
+    });
+    root.add([pctx](IAsyncSteps&, int res) { pctx->accepted = res; });
+    root.execute();
+    reactor.iterate();
+
+    int client = ::socket(AF_INET, SOCK_STREAM, 0);
+    BOOST_REQUIRE_EQUAL(
+            ::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)),
+            0);
+
+    reactor.run();
+    BOOST_CHECK_GE(ctx.accepted, 0);
+
+    // Error, bad descriptor
+    ctx.error.clear();
+    root.add(
+            [pctx](IAsyncSteps& asi) {
+                pctx->reactor.accept(asi, -1);
+            },
+            on_error);
+    root.execute();
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(ctx.error, futoin::errors::CommError);
+    BOOST_CHECK_EQUAL(reactor.io_count(), 0U);
+
+    ::close(ctx.accepted);
+    ::close(client);
+    ::close(srv);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // NOLINT
+
+#endif